@@ -12,23 +12,50 @@
 
 #include <algorithm>
 #include <any>
+#include <atomic>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <concepts>
+#include <condition_variable>
+#include <exception>
+#include <expected>
+#include <filesystem>
 #include <format>
+#include <fstream>
 #include <functional>
-#include <map>
+#include <iterator>
+#include <list>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
 #include <optional>
 #include <print>
 #include <ranges>
+#include <span>
 #include <sstream>
 #include <stdexcept>
+#include <stop_token>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <type_traits>
 #include <typeinfo>
+#include <unordered_map>
 #include <utility>
 #include <variant>
 #include <vector>
+#include <cctype>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
+
+#if defined(__APPLE__)
+#include <crt_externs.h>
+#elif !defined(_WIN32)
+#include <unistd.h>
+#endif
 
 
 namespace argparse
@@ -90,6 +117,149 @@ namespace argparse
             using logic_error::logic_error;
     };
 
+    class buffer_error
+      : public std::runtime_error
+    {
+        public:
+            using runtime_error::runtime_error;
+    };
+
+    template<std::size_t N>
+    struct FixedString
+    {
+        constexpr FixedString(char const (&string)[N])
+        {
+            std::ranges::copy(string, chars.begin());
+        }
+
+        constexpr auto view() const -> std::string_view
+        {
+            return std::string_view(chars.data(), N - 1);
+        }
+
+        std::array<char, N> chars{};
+    };
+
+    struct ArgType
+    {
+        template<typename T>
+        static constexpr auto of() -> ArgType;
+
+        void const * (*handler)() = nullptr;
+    };
+
+    struct ArgSpec
+    {
+        std::array<std::string_view, 2> names{};
+        std::string_view help{};
+        std::string_view metavar{};
+        std::string_view dest{};
+        Action action = store;
+        std::string_view version{};
+        ArgType type{};
+        std::optional<std::string_view> const_{};
+        std::optional<std::string_view> default_{};
+        bool required = false;
+        std::span<std::string_view const> choices{};
+        std::optional<std::variant<std::size_t, Nargs>> nargs{};
+    };
+
+    struct Fingerprint
+    {
+        std::uint64_t high = 0;
+        std::uint64_t low = 0;
+
+        auto to_string() const -> std::string
+        {
+            return std::format("{:016x}{:016x}", high, low);
+        }
+
+        friend auto operator==(Fingerprint const &, Fingerprint const &) -> bool = default;
+    };
+
+    namespace detail
+    {
+        inline auto murmur_hash3(std::span<char const> data, std::uint64_t seed = 0) -> Fingerprint
+        {
+            auto const c1 = std::uint64_t(0x87c37b91114253d5);
+            auto const c2 = std::uint64_t(0x4cf5ad432745937f);
+            auto const fmix = [](std::uint64_t k)
+            {
+                k ^= k >> 33;
+                k *= 0xff51afd7ed558ccd;
+                k ^= k >> 33;
+                k *= 0xc4ceb9fe1a85ec53;
+                k ^= k >> 33;
+                return k;
+            };
+            auto const byte = [&](std::size_t index) { return std::uint64_t(static_cast<unsigned char>(data[index])); };
+            auto const load = [&](std::size_t offset)
+            {
+                auto k = std::uint64_t();
+                for (auto i = std::size_t(0); i != sizeof(k); ++i)
+                {
+                    k |= byte(offset + i) << (i * 8);
+                }
+                return k;
+            };
+
+            auto h1 = seed;
+            auto h2 = seed;
+            auto const blocks = data.size() / 16;
+
+            for (auto i = std::size_t(0); i != blocks; ++i)
+            {
+                auto const k1 = load(i * 16);
+                auto const k2 = load(i * 16 + 8);
+
+                h1 ^= std::rotl(k1 * c1, 31) * c2;
+                h1 = (std::rotl(h1, 27) + h2) * 5 + 0x52dce729;
+                h2 ^= std::rotl(k2 * c2, 33) * c1;
+                h2 = (std::rotl(h2, 31) + h1) * 5 + 0x38495ab5;
+            }
+
+            auto const tail = blocks * 16;
+            auto const remainder = data.size() - tail;
+            auto k1 = std::uint64_t();
+            auto k2 = std::uint64_t();
+
+            for (auto i = remainder; i > 8; --i)
+            {
+                k2 ^= byte(tail + i - 1) << ((i - 9) * 8);
+            }
+            if (remainder > 8)
+            {
+                h2 ^= std::rotl(k2 * c2, 33) * c1;
+            }
+
+            for (auto i = std::min<std::size_t>(remainder, 8); i > 0; --i)
+            {
+                k1 ^= byte(tail + i - 1) << ((i - 1) * 8);
+            }
+            if (remainder > 0)
+            {
+                h1 ^= std::rotl(k1 * c1, 31) * c2;
+            }
+
+            h1 ^= data.size();
+            h2 ^= data.size();
+            h1 += h2;
+            h2 += h1;
+            h1 = fmix(h1);
+            h2 = fmix(h2);
+            h1 += h2;
+            h2 += h1;
+
+            return Fingerprint{h2, h1};
+        }
+    }
+
+    struct CacheStats
+    {
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+    };
+
     inline auto operator|(Handle lhs, Handle rhs) -> Handle
     {
         return static_cast<Handle>(std::to_underlying(lhs) | std::to_underlying(rhs));
@@ -100,6 +270,11 @@ namespace argparse
         return std::to_underlying(lhs) & std::to_underlying(rhs);
     }
 
+    struct ConversionError
+    {
+        std::string message;
+    };
+
     template<typename T>
     class Converter
     {
@@ -129,13 +304,32 @@ namespace argparse
             {
                 return lhs == rhs;
             }
+
+            static constexpr auto default_equality = true;
+    };
+
+    template<typename T>
+    concept expected_converter = requires(Converter<T> const & conv, std::string_view s)
+    {
+        { conv.from_string(s) } -> std::same_as<std::expected<T, ConversionError>>;
     };
 
     template<typename T>
     inline auto from_string(std::string const & s) -> std::optional<T>
     {
         auto const conv = Converter<T>();
-        return conv.from_string(s);
+        if constexpr (expected_converter<T>)
+        {
+            if (auto value = conv.from_string(std::string_view(s)); value.has_value())
+            {
+                return *std::move(value);
+            }
+            return std::nullopt;
+        }
+        else
+        {
+            return conv.from_string(s);
+        }
     }
 
     template<typename T>
@@ -152,253 +346,1733 @@ namespace argparse
         return conv.are_equal(lhs, rhs);
     }
 
-    class ArgumentParser
+    template<typename T>
+    struct EnumName
     {
-        private:
-            class Value
-            {
-                public:
-                    explicit Value(auto const & t)
-                      : m_value(t)
-                    {
-                    }
-
-                    explicit operator bool() const
-                    {
-                        return m_value.has_value();
-                    }
-
-                    auto get() const -> std::string
-                    {
-                        return get<std::string>();
-                    }
-
-                    template<typename T>
-                    auto get() const -> T
-                    {
-                        if (m_value.type() != typeid(T))
-                        {
-                            throw type_error(std::format("wrong type: requested '{}' for argument of type '{}'", typeid(T).name(), m_value.type().name()));
-                        }
-
-                        return std::any_cast<T>(m_value);
-                    }
-
-                private:
-                    std::any m_value;
-            };
-
-            class Parameters
-            {
-                public:
-                    auto get(std::string_view name) const -> Value
-                    {
-                        if (auto const it = m_parameters.find(name); it == m_parameters.end())
-                        {
-                            throw name_error(std::format("no such argument: '{}'", name));
-                        }
-                        else
-                        {
-                            return it->second;
-                        }
-                    }
-
-                    auto get_value(std::string_view name) const -> std::string
-                    {
-                        return get(name).get();
-                    }
-
-                    template<typename T>
-                    auto get_value(std::string_view name) const -> T
-                    {
-                        return get(name).get<T>();
-                    }
-
-                    auto insert(std::string const & name, std::any const & value) -> void
-                    {
-                        (void) m_parameters.try_emplace(name, value);
-                    }
+        std::string_view name;
+        T value;
+    };
 
-                private:
-                    std::map<std::string, Value, std::less<>> m_parameters;
-            };
+    template<auto const & Names>
+    class EnumConverter
+    {
+        private:
+            using T = std::remove_cvref_t<decltype(Names.front().value)>;
 
-            struct Token
+            static constexpr auto by_name = []
             {
-                std::string m_token;
-                bool m_consumed = false;
-            };
-
-            using Tokens = std::vector<Token>;
-            using OptString = std::optional<std::string>;
+                auto sorted = Names;
+                std::ranges::sort(sorted, {}, &EnumName<T>::name);
+                return sorted;
+            }();
 
-            class HelpRequested {};
-            class VersionRequested {};
+            static_assert(std::ranges::adjacent_find(by_name, {}, &EnumName<T>::name) == by_name.end(), "enum names must be unique");
 
         public:
-            template<typename ...Args>
-            decltype(auto) add_argument(Args &&... names)
-            {
-                return ArgumentBuilder(m_arguments, m_version, std::vector<std::string>{names...});
-            }
-
-            auto parse_args(int argc, char const * const argv[]) -> Parameters
+            auto from_string(std::string_view s) const -> std::expected<T, ConversionError>
             {
-                if (!m_prog)
+                if (auto const it = std::ranges::lower_bound(by_name, s, {}, &EnumName<T>::name); it != by_name.end() && it->name == s)
                 {
-                    m_prog = extract_filename(argv[0]);
+                    return it->value;
                 }
 
-                try
-                {
-                    return parse_args(get_tokens(argc, argv));
-                }
-                catch (HelpRequested const &)
+                auto message = std::string("choose from ");
+                for (auto const & name : Names)
                 {
-                    if (m_handle & Handle::help)
+                    if (&name != &Names.front())
                     {
-                        std::println("{}", format_help());
-                        std::exit(EXIT_SUCCESS);
+                        message += ", ";
                     }
-
-                    return get_parameters(m_arguments | std::views::transform(cast_to_argument));
+                    message += name.name;
                 }
-                catch (VersionRequested const &)
-                {
-                    if (m_handle & Handle::version)
-                    {
-                        std::println("{}", format_version());
-                        std::exit(EXIT_SUCCESS);
-                    }
+                return std::unexpected(ConversionError{std::move(message)});
+            }
 
-                    return get_parameters(m_arguments | std::views::transform(cast_to_argument));
-                }
-                catch (parsing_error const & e)
+            auto to_string(T const & t) const -> std::string
+            {
+                if (auto const it = std::ranges::find(Names, t, &EnumName<T>::value); it != Names.end())
                 {
-                    if (m_handle & Handle::errors)
-                    {
-                        std::println("{}", e.what());
-                        std::println("{}", format_help());
-                        std::exit(EXIT_FAILURE);
-                    }
-
-                    throw;
+                    return std::string(it->name);
                 }
+                return std::to_string(std::to_underlying(t));
             }
 
-            auto add_mutually_exclusive_group()
+            auto are_equal(T const & lhs, T const & rhs) const -> bool
             {
-                return MutuallyExclusiveGroup(m_arguments, m_version);
+                return lhs == rhs;
             }
 
-            auto prog(std::string prog) -> ArgumentParser &&
-            {
-                m_prog = std::move(prog);
+            static constexpr auto default_equality = true;
 
-                return std::move(*this);
+            static auto choices() -> std::vector<std::any>
+            {
+                return Names
+                    | std::views::transform([](auto const & name) { return std::any(name.value); })
+                    | std::ranges::to<std::vector>();
             }
+    };
 
-            auto usage(std::string usage) -> ArgumentParser &&
+    class ShellWords
+    {
+        public:
+            explicit ShellWords(std::string_view command)
+              : m_command(command)
             {
-                m_usage = std::move(usage);
+                for (auto pos = skip_blanks(0); pos != m_command.size(); pos = skip_blanks(pos))
+                {
+                    if (m_command[pos] == '#')
+                    {
+                        pos = std::min(m_command.find('\n', pos), m_command.size());
+                        continue;
+                    }
 
-                return std::move(*this);
+                    pos = split_word(pos);
+                }
             }
 
-            auto description(std::string description) -> ArgumentParser &&
-            {
-                m_description = std::move(description);
+            ShellWords(ShellWords const &) = delete;
+            ShellWords(ShellWords &&) noexcept = default;
 
-                return std::move(*this);
-            }
+            ShellWords & operator=(ShellWords const &) = delete;
+            ShellWords & operator=(ShellWords &&) noexcept = default;
 
-            auto epilog(std::string epilog) -> ArgumentParser &&
+            auto begin() const
             {
-                m_epilog = std::move(epilog);
-
-                return std::move(*this);
+                return m_words.begin();
             }
 
-            auto add_help(bool add) -> ArgumentParser &&
+            auto end() const
             {
-                if (!add)
-                {
-                    (void) m_arguments.erase(m_arguments.begin());
-                }
-
-                return std::move(*this);
+                return m_words.end();
             }
 
-            auto handle(Handle handle) -> ArgumentParser &&
+            auto size() const -> std::size_t
             {
-                m_handle = handle;
-
-                return std::move(*this);
+                return m_words.size();
             }
 
-            auto format_usage() const -> std::string
+            auto operator[](std::size_t index) const -> std::string_view
             {
-                return Formatter::format_usage(m_arguments | std::views::transform(cast_to_formattable), m_usage, m_prog);
+                return m_words[index];
             }
 
-            auto format_help() const -> std::string
+        private:
+            static constexpr auto is_blank(char c) -> bool
             {
-                return Formatter::format_help(m_arguments | std::views::transform(cast_to_formattable), m_prog, m_usage, m_description, m_epilog);
+                return c == ' ' || c == '\t' || c == '\n' || c == '\r';
             }
 
-            auto format_version() const -> std::string
+            static constexpr auto is_special(char c) -> bool
             {
-                return Formatter::format_version(m_version, m_prog);
+                return is_blank(c) || c == '\'' || c == '"' || c == '\\';
             }
 
-            ArgumentParser()
+            static constexpr auto has_byte(std::uint64_t word, char c) -> std::uint64_t
             {
-                add_argument("-h", "--help").action(help).help("show this help message and exit");
+                constexpr auto ones = std::uint64_t(0x0101010101010101);
+                constexpr auto highs = std::uint64_t(0x8080808080808080);
+                auto const x = word ^ (ones * static_cast<unsigned char>(c));
+                return (x - ones) & ~x & highs;
             }
 
-        private:
-            static auto extract_filename(std::string_view path) -> std::string_view
+            auto find_special(std::size_t pos) const -> std::size_t
             {
-                if (auto path_separator = path.find_last_of("/\\"); path_separator != std::string_view::npos)
+                auto const size = m_command.size();
+                for (auto word = std::uint64_t(); pos + sizeof(word) <= size; pos += sizeof(word))
                 {
-                    return path.substr(path_separator + 1);
+                    std::memcpy(&word, m_command.data() + pos, sizeof(word));
+                    if (has_byte(word, ' ') | has_byte(word, '\t') | has_byte(word, '\n') | has_byte(word, '\r')
+                        | has_byte(word, '\'') | has_byte(word, '"') | has_byte(word, '\\'))
+                    {
+                        break;
+                    }
                 }
 
-                return path;
+                while (pos != size && !is_special(m_command[pos]))
+                {
+                    ++pos;
+                }
+
+                return pos;
             }
 
-            auto parse_args(Tokens tokens) -> Parameters
+            auto skip_blanks(std::size_t pos) const -> std::size_t
             {
-                auto arguments = m_arguments | std::views::transform(cast_to_argument);
-
-                parse_optional_arguments(arguments, tokens);
-                parse_positional_arguments(arguments, tokens);
-
-                consume_pseudo_arguments(tokens);
-
-                check_unrecognised_arguments(tokens);
-                check_excluded_arguments(arguments);
-                check_missing_arguments(arguments);
+                while (pos != m_command.size() && is_blank(m_command[pos]))
+                {
+                    ++pos;
+                }
 
-                return get_parameters(arguments);
+                return pos;
             }
 
-            static auto get_tokens(int argc, char const * const argv[]) -> Tokens
+            auto split_word(std::size_t pos) -> std::size_t
             {
-                return Tokens(&argv[1], &argv[argc]);
-            }
+                auto const size = m_command.size();
+                auto pieces = std::size_t(0);
+                auto quoted = false;
+                auto word = std::string_view();
+                auto * out = static_cast<char *>(nullptr);
 
-            static auto join(std::vector<std::string> const & strings, std::string_view separator) -> std::string
-            {
-                return join(strings | std::views::all, separator);
-            }
+                auto const append = [&](std::size_t first, std::size_t last)
+                {
+                    auto const piece = m_command.substr(first, last - first);
+                    if (pieces++ == 0)
+                    {
+                        word = piece;
+                        return;
+                    }
 
-            static auto join(std::ranges::view auto strings, std::string_view separator) -> std::string
+                    if (pieces == 2)
+                    {
+                        out = allocate();
+                        std::ranges::copy(word, out);
+                    }
+
+                    std::ranges::copy(piece, out + word.size());
+                    word = std::string_view(out, word.size() + piece.size());
+                };
+
+                while (pos != size && !is_blank(m_command[pos]))
+                {
+                    switch (m_command[pos])
+                    {
+                        case '\'':
+                        {
+                            quoted = true;
+                            auto const close = m_command.find('\'', pos + 1);
+                            if (close == std::string_view::npos)
+                            {
+                                throw parsing_error("no closing quotation");
+                            }
+                            append(pos + 1, close);
+                            pos = close + 1;
+                            break;
+                        }
+                        case '"':
+                        {
+                            quoted = true;
+                            for (++pos;;)
+                            {
+                                auto const next = m_command.find_first_of("\"\\", pos);
+                                if (next == std::string_view::npos || (m_command[next] == '\\' && next + 1 == size))
+                                {
+                                    throw parsing_error("no closing quotation");
+                                }
+                                append(pos, next);
+                                if (m_command[next] == '"')
+                                {
+                                    pos = next + 1;
+                                    break;
+                                }
+                                auto const escaped = m_command[next + 1];
+                                if (escaped == '\\' || escaped == '"' || escaped == '$' || escaped == '`')
+                                {
+                                    append(next + 1, next + 2);
+                                }
+                                else if (escaped != '\n')
+                                {
+                                    append(next, next + 2);
+                                }
+                                pos = next + 2;
+                            }
+                            break;
+                        }
+                        case '\\':
+                        {
+                            if (pos + 1 == size)
+                            {
+                                throw parsing_error("no escaped character");
+                            }
+                            if (m_command[pos + 1] != '\n')
+                            {
+                                append(pos + 1, pos + 2);
+                            }
+                            pos += 2;
+                            break;
+                        }
+                        default:
+                        {
+                            auto const next = find_special(pos);
+                            append(pos, next);
+                            pos = next;
+                            break;
+                        }
+                    }
+                }
+
+                if (pieces > 1)
+                {
+                    m_used += word.size();
+                }
+
+                if (pieces != 0 || quoted)
+                {
+                    m_words.push_back(word);
+                }
+
+                return pos;
+            }
+
+            auto allocate() -> char *
+            {
+                if (!m_storage)
+                {
+                    m_storage = std::make_unique_for_overwrite<char[]>(m_command.size());
+                }
+
+                return m_storage.get() + m_used;
+            }
+
+            std::string_view m_command;
+            std::vector<std::string_view> m_words;
+            std::unique_ptr<char[]> m_storage;
+            std::size_t m_used = 0;
+    };
+
+    class ArgumentParser
+    {
+        private:
+            friend struct ArgType;
+
+            class Parameters;
+            class TypeHandler;
+
+            class Value
+            {
+                public:
+                    explicit Value(auto const & t)
+                      : m_value(t)
+                    {
+                    }
+
+                    explicit operator bool() const
+                    {
+                        return m_value.has_value();
+                    }
+
+                    auto get() const -> std::string
+                    {
+                        return get<std::string>();
+                    }
+
+                    template<typename T>
+                    auto get() const -> T
+                    {
+                        if (m_value.type() != typeid(T))
+                        {
+                            throw type_error(std::format("wrong type: requested '{}' for argument of type '{}'", typeid(T).name(), m_value.type().name()));
+                        }
+
+                        return std::any_cast<T>(m_value);
+                    }
+
+                    template<typename T>
+                    auto get_ref() const -> T const &
+                    {
+                        if (m_value.type() != typeid(T))
+                        {
+                            throw type_error(std::format("wrong type: requested '{}' for argument of type '{}'", typeid(T).name(), m_value.type().name()));
+                        }
+
+                        return *std::any_cast<T>(&m_value);
+                    }
+
+                private:
+                    friend class ArgumentParser;
+                    friend class Parameters;
+
+                    std::any m_value;
+            };
+
+            enum class BinaryKind : std::uint16_t
+            {
+                none,
+                boolean,
+                signed_integer,
+                unsigned_integer,
+                floating_point,
+                string
+            };
+
+            struct BinaryHeader
+            {
+                std::uint32_t magic;
+                std::uint32_t count;
+                std::uint32_t size;
+                std::uint32_t reserved;
+            };
+
+            struct BinaryEntry
+            {
+                std::uint32_t name_offset;
+                std::uint32_t name_size;
+                std::uint32_t value_offset;
+                std::uint32_t value_size;
+                BinaryKind kind;
+                std::uint8_t width;
+                std::uint8_t vector;
+                std::uint32_t reserved;
+            };
+
+            static constexpr auto binary_magic = std::uint32_t(0x31425041);
+
+            using FlagIndices = std::vector<std::pair<std::string, std::size_t>>;
+
+            class Parameters
+            {
+                private:
+                    using Entries = std::pmr::vector<std::pair<std::pmr::string, Value>>;
+
+                public:
+                    explicit Parameters(std::pmr::memory_resource * resource = std::pmr::get_default_resource(), std::shared_ptr<Parameters const> defaults = nullptr)
+                      : m_parameters(resource)
+                      , m_defaults(std::move(defaults))
+                      , m_flags(resource)
+                    {
+                    }
+
+                    auto get(std::string_view name) const -> Value
+                    {
+                        return lookup(name);
+                    }
+
+                    auto get_value(std::string_view name) const -> std::string
+                    {
+                        return get(name).get();
+                    }
+
+                    template<typename T>
+                    auto get_value(std::string_view name) const -> T
+                    {
+                        return get(name).get<T>();
+                    }
+
+                    auto get_value_ref(std::string_view name) const -> std::string const &
+                    {
+                        return lookup(name).get_ref<std::string>();
+                    }
+
+                    template<typename T>
+                    auto get_value_ref(std::string_view name) const -> T const &
+                    {
+                        return lookup(name).get_ref<T>();
+                    }
+
+                    auto get_flag(std::size_t index) const -> bool
+                    {
+                        if (index >= m_flag_count)
+                        {
+                            throw name_error(std::format("no such flag: {}", index));
+                        }
+
+                        return (m_flags[index / 64] >> (index % 64)) & 1;
+                    }
+
+                    auto insert(std::string const & name, std::any const & value) -> void
+                    {
+                        if (auto const it = find(name); it == m_parameters.end() || std::string_view(it->first) != name)
+                        {
+                            (void) m_parameters.emplace(it, std::pmr::string(name, m_parameters.get_allocator()), Value(value));
+                        }
+                    }
+
+                    auto serialize() const -> std::vector<std::byte>
+                    {
+                        auto entries = std::vector<std::pair<std::string_view, std::any const *>>();
+                        for (auto const * parameters = this; parameters != nullptr; parameters = parameters->m_defaults.get())
+                        {
+                            for (auto const & [name, value] : parameters->m_parameters)
+                            {
+                                entries.emplace_back(name, &value.m_value);
+                            }
+                            if (parameters->m_flag_indices)
+                            {
+                                for (auto const & [name, index] : *parameters->m_flag_indices)
+                                {
+                                    entries.emplace_back(name, &get_flag_value(parameters->get_flag(index)).m_value);
+                                }
+                            }
+                        }
+                        std::ranges::stable_sort(entries, {}, &std::pair<std::string_view, std::any const *>::first);
+                        auto const duplicates = std::ranges::unique(entries, {}, &std::pair<std::string_view, std::any const *>::first);
+                        (void) entries.erase(duplicates.begin(), duplicates.end());
+
+                        auto bytes = std::vector<std::byte>(sizeof(BinaryHeader) + entries.size() * sizeof(BinaryEntry));
+                        auto table = std::vector<BinaryEntry>(entries.size());
+
+                        for (auto i = std::size_t(0); i != entries.size(); ++i)
+                        {
+                            table[i].name_offset = static_cast<std::uint32_t>(bytes.size());
+                            table[i].name_size = static_cast<std::uint32_t>(entries[i].first.size());
+                            append_bytes(bytes, entries[i].first.data(), entries[i].first.size());
+                        }
+
+                        for (auto i = std::size_t(0); i != entries.size(); ++i)
+                        {
+                            auto const & [name, value] = entries[i];
+                            if (value->has_value() && !write_binary<bool, char, signed char, unsigned char, short, unsigned short, int, unsigned, long, unsigned long, long long, unsigned long long, float, double, std::string>(bytes, *value, table[i]))
+                            {
+                                throw type_error(std::format("cannot serialise argument '{}' of type '{}'", name, value->type().name()));
+                            }
+                        }
+
+                        auto const header = BinaryHeader{binary_magic, static_cast<std::uint32_t>(table.size()), static_cast<std::uint32_t>(bytes.size()), 0};
+                        std::memcpy(bytes.data(), &header, sizeof(header));
+                        std::memcpy(bytes.data() + sizeof(header), table.data(), table.size() * sizeof(BinaryEntry));
+
+                        return bytes;
+                    }
+
+                    auto insert_flag(bool value) -> void
+                    {
+                        if (m_flag_count % 64 == 0)
+                        {
+                            m_flags.push_back(0);
+                        }
+
+                        m_flags.back() |= std::uint64_t(value) << (m_flag_count % 64);
+                        ++m_flag_count;
+                    }
+
+                private:
+                    friend class ArgumentParser;
+
+                    auto lookup(std::string_view name) const -> Value const &
+                    {
+                        if (auto const it = find(name); it != m_parameters.end() && it->first == name)
+                        {
+                            return it->second;
+                        }
+                        else if (auto const index = find_flag(name))
+                        {
+                            return get_flag_value(get_flag(*index));
+                        }
+                        else if (m_defaults)
+                        {
+                            return m_defaults->lookup(name);
+                        }
+                        else
+                        {
+                            throw name_error(std::format("no such argument: '{}'", name));
+                        }
+                    }
+
+                    auto find_flag(std::string_view name) const -> std::optional<std::size_t>
+                    {
+                        if (m_flag_indices)
+                        {
+                            auto const it = std::ranges::lower_bound(*m_flag_indices, name, std::less<>(), [](auto const & entry) -> std::string_view { return entry.first; });
+                            if (it != m_flag_indices->end() && it->first == name)
+                            {
+                                return it->second;
+                            }
+                        }
+                        return std::nullopt;
+                    }
+
+                    static auto get_flag_value(bool flag) -> Value const &
+                    {
+                        static auto const values = std::array{Value(false), Value(true)};
+                        return values[flag ? 1 : 0];
+                    }
+
+                    auto find(std::string_view name) const -> Entries::const_iterator
+                    {
+                        return std::ranges::lower_bound(m_parameters, name, std::less<>(), [](auto const & entry) -> std::string_view { return entry.first; });
+                    }
+
+                    auto append(std::string const & name, std::any const & value) -> void
+                    {
+                        (void) m_parameters.emplace_back(std::pmr::string(name, m_parameters.get_allocator()), Value(value));
+                    }
+
+                    static auto append_bytes(std::vector<std::byte> & bytes, void const * data, std::size_t size) -> void
+                    {
+                        auto const offset = bytes.size();
+                        bytes.resize(offset + size);
+                        if (size != 0)
+                        {
+                            std::memcpy(bytes.data() + offset, data, size);
+                        }
+                    }
+
+                    template<typename ...Ts>
+                    static auto write_binary(std::vector<std::byte> & bytes, std::any const & value, BinaryEntry & entry) -> bool
+                    {
+                        return (write_binary_one<Ts>(bytes, value, entry) || ...);
+                    }
+
+                    template<typename T>
+                    static auto write_binary_one(std::vector<std::byte> & bytes, std::any const & value, BinaryEntry & entry) -> bool
+                    {
+                        if (auto const * scalar = std::any_cast<T>(&value))
+                        {
+                            write_binary_array<T>(bytes, std::span(scalar, 1), entry);
+                            entry.vector = 0;
+                            return true;
+                        }
+
+                        if (auto const * vector = std::any_cast<std::vector<T>>(&value))
+                        {
+                            write_binary_array<T>(bytes, *vector, entry);
+                            entry.vector = 1;
+                            return true;
+                        }
+
+                        return false;
+                    }
+
+                    template<typename T>
+                    static auto write_binary_array(std::vector<std::byte> & bytes, std::ranges::sized_range auto const & values, BinaryEntry & entry) -> void
+                    {
+                        bytes.resize((bytes.size() + 7) / 8 * 8);
+
+                        entry.kind = binary_kind<T>();
+                        entry.value_offset = static_cast<std::uint32_t>(bytes.size());
+                        entry.value_size = static_cast<std::uint32_t>(std::ranges::size(values));
+
+                        if constexpr (std::same_as<T, std::string>)
+                        {
+                            entry.width = 2 * sizeof(std::uint32_t);
+
+                            auto offset = bytes.size() + std::ranges::size(values) * entry.width;
+                            for (auto const & value : values)
+                            {
+                                std::uint32_t const location[] = {static_cast<std::uint32_t>(offset), static_cast<std::uint32_t>(value.size())};
+                                append_bytes(bytes, location, sizeof(location));
+                                offset += value.size();
+                            }
+
+                            for (auto const & value : values)
+                            {
+                                append_bytes(bytes, value.data(), value.size());
+                            }
+                        }
+                        else
+                        {
+                            entry.width = sizeof(T);
+
+                            for (T const value : values)
+                            {
+                                append_bytes(bytes, &value, sizeof(T));
+                            }
+                        }
+                    }
+
+                    auto sort() -> void
+                    {
+                        std::ranges::stable_sort(m_parameters, std::less<>(), [](auto const & entry) -> std::string_view { return entry.first; });
+                        auto const duplicates = std::ranges::unique(m_parameters, std::equal_to<>(), [](auto const & entry) -> std::string_view { return entry.first; });
+                        (void) m_parameters.erase(duplicates.begin(), duplicates.end());
+                    }
+
+                    Entries m_parameters;
+                    std::shared_ptr<Parameters const> m_defaults;
+                    std::shared_ptr<FlagIndices const> m_flag_indices;
+                    std::pmr::vector<std::uint64_t> m_flags;
+                    std::size_t m_flag_count = 0;
+            };
+
+            struct Token
+            {
+                std::pmr::string m_token;
+                bool m_consumed = false;
+            };
+
+            using Tokens = std::pmr::vector<Token>;
+            using OptString = std::optional<std::string>;
+
+            class Environment
+            {
+                public:
+                    explicit Environment(char const * const * variables)
+                    {
+                        for (; variables != nullptr && *variables != nullptr; ++variables)
+                        {
+                            auto const variable = std::string_view(*variables);
+                            if (auto const pos = variable.find('='); pos != std::string_view::npos && pos != 0)
+                            {
+                                m_variables.emplace_back(variable.substr(0, pos), variable.substr(pos + 1));
+                            }
+                        }
+
+                        std::ranges::stable_sort(m_variables, {}, &Variable::first);
+                    }
+
+                    auto find(std::string_view name) const -> std::optional<std::string_view>
+                    {
+                        auto const it = std::ranges::lower_bound(m_variables, name, {}, &Variable::first);
+                        if (it != m_variables.end() && it->first == name)
+                        {
+                            return it->second;
+                        }
+                        return std::nullopt;
+                    }
+
+                private:
+                    using Variable = std::pair<std::string_view, std::string_view>;
+
+                    std::vector<Variable> m_variables;
+            };
+
+            class ConfigFile
+            {
+                public:
+                    explicit ConfigFile(std::filesystem::path const & path)
+                    {
+                        auto error = std::error_code();
+                        auto const size = std::filesystem::file_size(path, error);
+                        auto file = std::ifstream(path, std::ios::binary);
+                        if (error || !file)
+                        {
+                            throw parsing_error(std::format("can't open '{}'", path.string()));
+                        }
+
+                        m_buffer.resize(static_cast<std::size_t>(size));
+                        file.read(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+                        if (file.bad())
+                        {
+                            throw parsing_error(std::format("can't open '{}'", path.string()));
+                        }
+                        m_buffer.resize(static_cast<std::size_t>(file.gcount()));
+
+                        parse(path);
+                    }
+
+                    ConfigFile(ConfigFile const &) = delete;
+                    ConfigFile & operator=(ConfigFile const &) = delete;
+
+                    auto find(std::string_view key) const -> std::optional<std::string_view>
+                    {
+                        auto const it = std::ranges::upper_bound(m_entries, key, {}, &Entry::first);
+                        if (it != m_entries.begin() && std::ranges::prev(it)->first == key)
+                        {
+                            return std::ranges::prev(it)->second;
+                        }
+                        return std::nullopt;
+                    }
+
+                    auto keys() const
+                    {
+                        return m_entries | std::views::keys;
+                    }
+
+                private:
+                    using Entry = std::pair<std::string_view, std::string_view>;
+
+                    static auto trim(std::string_view string) -> std::string_view
+                    {
+                        auto const is_space = [](char c) { return c == ' ' || c == '\t' || c == '\r'; };
+                        while (!string.empty() && is_space(string.front()))
+                        {
+                            string.remove_prefix(1);
+                        }
+                        while (!string.empty() && is_space(string.back()))
+                        {
+                            string.remove_suffix(1);
+                        }
+                        return string;
+                    }
+
+                    auto parse(std::filesystem::path const & path) -> void
+                    {
+                        auto rest = std::string_view(m_buffer);
+                        for (auto number = std::size_t(1); !rest.empty(); ++number)
+                        {
+                            auto const end = rest.find('\n');
+                            auto const line = trim(rest.substr(0, end));
+                            rest.remove_prefix(end == std::string_view::npos ? rest.size() : end + 1);
+
+                            if (line.empty() || line.front() == '#' || line.front() == ';' || (line.front() == '[' && line.back() == ']'))
+                            {
+                                continue;
+                            }
+
+                            auto const pos = line.find('=');
+                            auto const key = trim(line.substr(0, pos));
+                            if (pos == std::string_view::npos || key.empty())
+                            {
+                                throw parsing_error(std::format("{}:{}: expected 'key = value'", path.string(), number));
+                            }
+
+                            auto value = trim(line.substr(pos + 1));
+                            if (value.size() >= 2 && value.front() == '"' && value.back() == '"')
+                            {
+                                value = value.substr(1, value.size() - 2);
+                            }
+
+                            m_entries.emplace_back(key, value);
+                        }
+
+                        std::ranges::stable_sort(m_entries, {}, &Entry::first);
+                    }
+
+                    std::string m_buffer;
+                    std::vector<Entry> m_entries;
+            };
+
+            class HelpRequested {};
+            class VersionRequested {};
+
+        public:
+            class ParametersView
+            {
+                public:
+                    explicit ParametersView(std::span<std::byte const> bytes)
+                      : m_bytes(bytes)
+                    {
+                        auto header = BinaryHeader();
+                        if (m_bytes.size() < sizeof(header))
+                        {
+                            throw buffer_error("invalid parameters buffer");
+                        }
+
+                        std::memcpy(&header, m_bytes.data(), sizeof(header));
+                        if (header.magic != binary_magic || header.size < sizeof(header) || header.size > m_bytes.size() || (header.size - sizeof(header)) / sizeof(BinaryEntry) < header.count)
+                        {
+                            throw buffer_error("invalid parameters buffer");
+                        }
+
+                        m_count = header.count;
+
+                        for (auto i = std::size_t(0); i != m_count; ++i)
+                        {
+                            auto const entry = get_entry(i);
+
+                            if (!is_in_bounds(entry.name_offset, entry.name_size) || !is_in_bounds(entry.value_offset, std::size_t(entry.value_size) * entry.width)
+                                || (i != 0 && get_name(get_entry(i - 1)) >= get_name(entry)) || !is_well_formed(entry))
+                            {
+                                throw buffer_error("invalid parameters buffer");
+                            }
+
+                            if (entry.kind == BinaryKind::string)
+                            {
+                                for (auto j = std::size_t(0); j != entry.value_size; ++j)
+                                {
+                                    auto const [offset, size] = get_location(entry, j);
+                                    if (!is_in_bounds(offset, size))
+                                    {
+                                        throw buffer_error("invalid parameters buffer");
+                                    }
+                                }
+                            }
+                            else if (entry.kind == BinaryKind::boolean)
+                            {
+                                auto const values = m_bytes.subspan(entry.value_offset, entry.value_size);
+                                if (std::ranges::any_of(values, [](std::byte value) { return value > std::byte(1); }))
+                                {
+                                    throw buffer_error("invalid parameters buffer");
+                                }
+                            }
+                        }
+                    }
+
+                    auto has_value(std::string_view name) const -> bool
+                    {
+                        return find(name).kind != BinaryKind::none;
+                    }
+
+                    auto get_value(std::string_view name) const -> std::string_view
+                    {
+                        auto const entry = find<std::string>(name, false);
+                        auto const [offset, size] = get_location(entry, 0);
+                        return std::string_view(reinterpret_cast<char const *>(m_bytes.data() + offset), size);
+                    }
+
+                    template<typename T>
+                    auto get_value(std::string_view name) const -> T requires std::is_arithmetic_v<T>
+                    {
+                        auto const entry = find<T>(name, false);
+                        auto value = T();
+                        std::memcpy(&value, m_bytes.data() + entry.value_offset, sizeof(T));
+                        return value;
+                    }
+
+                    template<typename T>
+                    auto get_span(std::string_view name) const -> std::span<T const> requires std::is_arithmetic_v<T>
+                    {
+                        auto const entry = find<T>(name, true);
+                        auto const * data = m_bytes.data() + entry.value_offset;
+                        if (reinterpret_cast<std::uintptr_t>(data) % alignof(T) != 0)
+                        {
+                            throw buffer_error("misaligned parameters buffer");
+                        }
+                        return std::span(reinterpret_cast<T const *>(data), entry.value_size);
+                    }
+
+                    auto get_strings(std::string_view name) const
+                    {
+                        auto const entry = find<std::string>(name, true);
+                        return std::views::iota(std::size_t(0), std::size_t(entry.value_size))
+                            | std::views::transform([this, entry](std::size_t index)
+                                {
+                                    auto const [offset, size] = get_location(entry, index);
+                                    return std::string_view(reinterpret_cast<char const *>(m_bytes.data() + offset), size);
+                                });
+                    }
+
+                private:
+                    auto get_entry(std::size_t index) const -> BinaryEntry
+                    {
+                        auto entry = BinaryEntry();
+                        std::memcpy(&entry, m_bytes.data() + sizeof(BinaryHeader) + index * sizeof(BinaryEntry), sizeof(entry));
+                        return entry;
+                    }
+
+                    auto get_name(BinaryEntry const & entry) const -> std::string_view
+                    {
+                        return std::string_view(reinterpret_cast<char const *>(m_bytes.data() + entry.name_offset), entry.name_size);
+                    }
+
+                    auto get_location(BinaryEntry const & entry, std::size_t index) const -> std::array<std::uint32_t, 2>
+                    {
+                        auto location = std::array<std::uint32_t, 2>();
+                        std::memcpy(location.data(), m_bytes.data() + entry.value_offset + index * sizeof(location), sizeof(location));
+                        return location;
+                    }
+
+                    auto is_in_bounds(std::size_t offset, std::size_t size) const -> bool
+                    {
+                        return offset <= m_bytes.size() && size <= m_bytes.size() - offset;
+                    }
+
+                    static auto is_well_formed(BinaryEntry const & entry) -> bool
+                    {
+                        auto const is_width = [&](auto... widths) { return ((std::size_t(entry.width) == std::size_t(widths)) || ...); };
+
+                        auto valid_width = false;
+                        switch (entry.kind)
+                        {
+                            case BinaryKind::none:
+                                return entry.width == 0 && entry.value_size == 0 && entry.vector == 0;
+                            case BinaryKind::boolean:
+                                valid_width = is_width(sizeof(bool));
+                                break;
+                            case BinaryKind::signed_integer:
+                            case BinaryKind::unsigned_integer:
+                                valid_width = is_width(1, 2, 4, 8);
+                                break;
+                            case BinaryKind::floating_point:
+                                valid_width = is_width(sizeof(float), sizeof(double));
+                                break;
+                            case BinaryKind::string:
+                                valid_width = is_width(2 * sizeof(std::uint32_t));
+                                break;
+                            default:
+                                return false;
+                        }
+
+                        auto const alignment = entry.kind == BinaryKind::string ? sizeof(std::uint32_t) : entry.width;
+
+                        return valid_width && entry.value_offset % alignment == 0 && entry.vector <= 1 && (entry.vector == 1 || entry.value_size == 1);
+                    }
+
+                    auto find(std::string_view name) const -> BinaryEntry
+                    {
+                        auto const indices = std::views::iota(std::size_t(0), m_count);
+                        auto const it = std::ranges::lower_bound(indices, name, {}, [this](std::size_t index) { return get_name(get_entry(index)); });
+
+                        if (it == indices.end() || get_name(get_entry(*it)) != name)
+                        {
+                            throw name_error(std::format("no such argument: '{}'", name));
+                        }
+
+                        return get_entry(*it);
+                    }
+
+                    template<typename T>
+                    auto find(std::string_view name, bool vector) const -> BinaryEntry
+                    {
+                        auto const entry = find(name);
+
+                        if (entry.kind != binary_kind<T>() || (entry.kind != BinaryKind::string && entry.width != sizeof(T)) || bool(entry.vector) != vector)
+                        {
+                            throw type_error(std::format("wrong type: requested '{}' for argument '{}'", typeid(T).name(), name));
+                        }
+
+                        return entry;
+                    }
+
+                    std::span<std::byte const> m_bytes;
+                    std::size_t m_count = 0;
+            };
+
+            class Argv
+            {
+                public:
+                    Argv() = default;
+
+                    Argv(Argv const &) = delete;
+                    Argv(Argv &&) noexcept = default;
+
+                    Argv & operator=(Argv const &) = delete;
+                    Argv & operator=(Argv &&) noexcept = default;
+
+                    auto argc() const -> int
+                    {
+                        return static_cast<int>(m_offsets.size());
+                    }
+
+                    auto argv() const -> char * const *
+                    {
+                        return m_pointers.data();
+                    }
+
+                private:
+                    friend class ArgumentParser;
+
+                    auto push(std::string_view arg) -> void
+                    {
+                        m_offsets.push_back(m_buffer.size());
+                        m_buffer.insert(m_buffer.end(), arg.begin(), arg.end());
+                        m_buffer.push_back('\0');
+                    }
+
+                    auto push(TypeHandler const * handler, std::any const & value) -> void
+                    {
+                        m_offsets.push_back(m_buffer.size());
+                        handler->write(value, m_buffer);
+                        m_buffer.push_back('\0');
+                    }
+
+                    auto push(TypeHandler const * handler, std::any const & values, std::size_t index) -> void
+                    {
+                        m_offsets.push_back(m_buffer.size());
+                        handler->write(values, index, m_buffer);
+                        m_buffer.push_back('\0');
+                    }
+
+                    auto back() const -> std::string_view
+                    {
+                        return std::string_view(m_buffer.data() + m_offsets.back());
+                    }
+
+                    auto join_last(std::string_view separator) -> void
+                    {
+                        auto const position = m_buffer.begin() + static_cast<std::ptrdiff_t>(m_offsets.back()) - 1;
+                        m_buffer.insert(m_buffer.erase(position), separator.begin(), separator.end());
+                        m_offsets.pop_back();
+                    }
+
+                    auto append(Argv const & other) -> void
+                    {
+                        for (auto const offset : other.m_offsets)
+                        {
+                            m_offsets.push_back(m_buffer.size() + offset);
+                        }
+                        m_buffer.insert(m_buffer.end(), other.m_buffer.begin(), other.m_buffer.end());
+                    }
+
+                    auto finish() -> void
+                    {
+                        m_pointers.clear();
+                        for (auto const offset : m_offsets)
+                        {
+                            m_pointers.push_back(m_buffer.data() + offset);
+                        }
+                        m_pointers.push_back(nullptr);
+                    }
+
+                    std::vector<char> m_buffer;
+                    std::vector<std::size_t> m_offsets;
+                    std::vector<char *> m_pointers;
+            };
+
+            class SharedParameters
+            {
+                public:
+                    SharedParameters() = default;
+
+                    explicit SharedParameters(Parameters parameters)
+                      : m_current(std::make_shared<Parameters const>(std::move(parameters)))
+                    {
+                    }
+
+                    auto load() const -> std::shared_ptr<Parameters const>
+                    {
+                        return m_current.load(std::memory_order_acquire);
+                    }
+
+                    auto publish(Parameters parameters) -> std::shared_ptr<Parameters const>
+                    {
+                        auto current = std::make_shared<Parameters const>(std::move(parameters));
+                        m_current.store(current, std::memory_order_release);
+                        return current;
+                    }
+
+                private:
+                    std::atomic<std::shared_ptr<Parameters const>> m_current;
+            };
+
+            template<typename ...Args>
+            decltype(auto) add_argument(Args &&... names)
+            {
+                m_cache.clear();
+                return ArgumentBuilder(m_arguments, m_version, std::vector<std::string>{names...});
+            }
+
+            template<FixedString ...Names>
+            decltype(auto) add_argument()
+            {
+                check_names<Names...>();
+                m_cache.clear();
+                return ArgumentBuilder<get_kind<Names...>()>(m_arguments, m_version, std::vector<std::string>{std::string(Names.view())...});
+            }
+
+            auto parse_args(int argc, char const * const argv[]) -> Parameters
+            {
+                return parse_args(argc, argv, get_memory_resource());
+            }
+
+            auto parse_args(int argc, char const * const argv[], std::pmr::memory_resource * resource) -> Parameters
+            {
+                if (!m_prog)
+                {
+                    m_prog = extract_filename(argv[0]);
+                }
+
+                return parse_and_handle(get_tokens(std::span(&argv[1], &argv[argc]), resource));
+            }
+
+            auto parse_args(std::ranges::input_range auto && args) -> Parameters
+                requires std::convertible_to<std::ranges::range_reference_t<decltype(args)>, std::string_view>
+            {
+                return parse_args(std::forward<decltype(args)>(args), get_memory_resource());
+            }
+
+            auto parse_args(std::ranges::input_range auto && args, std::pmr::memory_resource * resource) -> Parameters
+                requires std::convertible_to<std::ranges::range_reference_t<decltype(args)>, std::string_view>
+            {
+                return parse_and_handle(get_tokens(std::forward<decltype(args)>(args), resource));
+            }
+
+            auto parse_command(std::string_view command) -> Parameters
+            {
+                auto * const resource = get_memory_resource();
+                return parse_and_handle([&] { return get_tokens(ShellWords(command), resource); }, resource);
+            }
+
+            auto parse_args_cached(int argc, char const * const argv[]) -> std::shared_ptr<Parameters const>
+            {
+                auto const args = std::span(&argv[1], &argv[argc]);
+                auto arguments = m_arguments | std::views::transform(cast_to_argument);
+
+                if (std::ranges::any_of(arguments, [](auto const & argument) { return argument.has_env(); }))
+                {
+                    return std::make_shared<Parameters const>(parse_args(argc, argv, std::pmr::new_delete_resource()));
+                }
+
+                if (m_cached_arguments != m_arguments.size())
+                {
+                    m_cache.clear();
+                    m_cached_arguments = m_arguments.size();
+                }
+
+                if (auto parameters = m_cache.find(args))
+                {
+                    return parameters;
+                }
+
+                auto parameters = std::make_shared<Parameters const>(parse_args(argc, argv, std::pmr::new_delete_resource()));
+                m_cache.insert(args, parameters);
+                return parameters;
+            }
+
+            auto cache_stats() const -> CacheStats
+            {
+                return m_cache.get_stats();
+            }
+
+            auto parse_batch(std::ranges::random_access_range auto && inputs, unsigned threads = std::thread::hardware_concurrency(), std::pmr::memory_resource * resource = std::pmr::new_delete_resource()) const -> std::vector<std::expected<Parameters, std::string>>
+            {
+                auto const size = static_cast<std::size_t>(std::ranges::size(inputs));
+                auto results = std::vector<std::expected<Parameters, std::string>>(size);
+                auto errors = std::vector<std::exception_ptr>(size);
+                auto next = std::atomic<std::size_t>(0);
+
+                auto const worker = [&]
+                {
+                    auto parser = *this;
+                    parser.m_handle = Handle::none;
+                    parser.m_memory_resource = resource;
+
+                    for (auto i = next++; i < size; i = next++)
+                    {
+                        try
+                        {
+                            auto const & input = std::ranges::begin(inputs)[static_cast<std::ranges::range_difference_t<decltype(inputs)>>(i)];
+                            results[i] = parser.parse_and_handle(get_tokens(input, resource));
+                        }
+                        catch (parsing_error const & e)
+                        {
+                            results[i] = std::unexpected(std::string(e.what()));
+                        }
+                        catch (...)
+                        {
+                            errors[i] = std::current_exception();
+                        }
+                    }
+                };
+
+                {
+                    auto workers = std::vector<std::jthread>();
+                    auto const count = std::clamp<std::size_t>(threads, 1, std::max<std::size_t>(size, 1));
+                    for (auto t = std::size_t(1); t < count; ++t)
+                    {
+                        workers.emplace_back(worker);
+                    }
+                    worker();
+                }
+
+                for (auto const & error : errors)
+                {
+                    if (error)
+                    {
+                        std::rethrow_exception(error);
+                    }
+                }
+
+                return results;
+            }
+
+            auto watch(std::filesystem::path path, std::shared_ptr<SharedParameters> shared, std::chrono::milliseconds interval = std::chrono::milliseconds(500), std::function<void(std::string const &)> on_error = {}) const -> std::jthread
+            {
+                if (!shared)
+                {
+                    throw option_error("watch needs a SharedParameters to publish to");
+                }
+
+                auto parser = *this;
+                parser.m_handle = Handle::none;
+
+                return std::jthread([parser = std::move(parser), path = std::move(path), shared = std::move(shared), interval, on_error = std::move(on_error)](std::stop_token stop) mutable
+                {
+                    auto mutex = std::mutex();
+                    auto wakeup = std::condition_variable_any();
+                    auto last_stamp = std::optional<FileStamp>();
+
+                    while (!stop.stop_requested())
+                    {
+                        auto const report = [&](std::string const & message)
+                        {
+                            if (on_error)
+                            {
+                                on_error(message);
+                            }
+                        };
+
+                        try
+                        {
+                            auto error = std::error_code();
+                            auto const write_time = std::filesystem::last_write_time(path, error);
+                            auto const size = error ? 0 : std::filesystem::file_size(path, error);
+                            if (!error)
+                            {
+                                auto const lines = read_argument_file(path);
+                                if (auto const stamp = FileStamp{write_time, size, hash_lines(lines)}; stamp != last_stamp)
+                                {
+                                    last_stamp = stamp;
+                                    (void) shared->publish(parser.parse_and_handle(get_tokens(lines, std::pmr::get_default_resource())));
+                                }
+                            }
+                        }
+                        catch (std::exception const & e)
+                        {
+                            report(e.what());
+                        }
+                        catch (...)
+                        {
+                            report("unknown error");
+                        }
+
+                        auto lock = std::unique_lock(mutex);
+                        (void) wakeup.wait_for(lock, stop, interval, [] { return false; });
+                    }
+                });
+            }
+
+            auto to_argv(Parameters const & parameters) const -> Argv
+            {
+                auto argv = Argv();
+                auto positionals = Argv();
+                auto needs_separator = false;
+
+                argv.push(m_prog.value_or(""));
+
+                for (auto const & argument : m_arguments | std::views::transform(cast_to_const_argument))
+                {
+                    auto const & value = parameters.lookup(argument.get_dest_name()).m_value;
+                    needs_separator = argument.unparse(value, argument.is_positional() ? positionals : argv) || needs_separator;
+                }
+
+                if (needs_separator && positionals.argc() != 0)
+                {
+                    argv.push("--");
+                }
+
+                argv.append(positionals);
+                argv.finish();
+
+                return argv;
+            }
+
+            auto fingerprint(Parameters const & parameters) const -> Fingerprint
+            {
+                auto arguments = m_arguments
+                    | std::views::transform([](auto const & av) { return &cast_to_const_argument(av); })
+                    | std::ranges::to<std::vector>();
+                std::ranges::sort(arguments, {}, [](auto const * argument) -> std::string const & { return argument->get_dest_name(); });
+
+                auto buffer = std::vector<char>();
+                for (auto const * argument : arguments)
+                {
+                    auto const size = buffer.size();
+                    if (!argument->canonicalise(parameters.lookup(argument->get_dest_name()).m_value, buffer))
+                    {
+                        buffer.resize(size);
+                    }
+                }
+
+                return detail::murmur_hash3(buffer);
+            }
+
+            auto to_json(Parameters const & parameters, std::output_iterator<char> auto out) const -> decltype(out)
+            {
+                auto arguments = m_arguments
+                    | std::views::transform([](auto const & av) { return &cast_to_const_argument(av); })
+                    | std::ranges::to<std::vector>();
+                std::ranges::stable_sort(arguments, {}, [](auto const * argument) -> std::string const & { return argument->get_dest_name(); });
+                auto const duplicates = std::ranges::unique(arguments, {}, [](auto const * argument) -> std::string const & { return argument->get_dest_name(); });
+                (void) arguments.erase(duplicates.begin(), duplicates.end());
+
+                auto scratch = std::vector<char>();
+
+                *out++ = '{';
+                for (auto const * argument : arguments)
+                {
+                    if (argument != arguments.front())
+                    {
+                        *out++ = ',';
+                    }
+                    out = write_json_string(argument->get_dest_name(), out);
+                    *out++ = ':';
+                    out = write_json_value(*argument, parameters.lookup(argument->get_dest_name()).m_value, scratch, out);
+                }
+                *out++ = '}';
+
+                return out;
+            }
+
+            auto to_json(Parameters const & parameters) const -> std::string
+            {
+                auto json = std::string();
+                (void) to_json(parameters, std::back_inserter(json));
+                return json;
+            }
+
+            auto flag_index(std::string_view name) -> std::size_t
+            {
+                auto const indices = get_flag_indices();
+                auto const it = std::ranges::lower_bound(*indices, name, std::less<>(), [](auto const & entry) -> std::string_view { return entry.first; });
+                if (it != indices->end() && it->first == name)
+                {
+                    return it->second;
+                }
+
+                if (std::ranges::any_of(m_arguments | std::views::transform(cast_to_const_argument), [&](auto const & argument) { return argument.get_dest_name() == name; }))
+                {
+                    throw type_error(std::format("argument '{}' is not a flag", name));
+                }
+
+                throw name_error(std::format("no such argument: '{}'", name));
+            }
+
+            auto reset() -> void
+            {
+                for (auto & argument : m_arguments | std::views::transform(cast_to_argument))
+                {
+                    argument.reset();
+                }
+            }
+
+            auto add_arguments(std::span<ArgSpec const> specs) -> void
+            {
+                std::ranges::for_each(specs, check_spec);
+                check_specs(specs);
+
+                auto all_options = specs | std::views::transform([](auto const & spec) { return get_options(spec); }) | std::ranges::to<std::vector>();
+
+                m_cache.clear();
+
+                for (auto const & spec : specs | std::views::filter([](auto const & spec) { return !spec.version.empty(); }))
+                {
+                    m_version = std::string(spec.version);
+                }
+
+                m_arguments.reserve(m_arguments.size() + specs.size());
+
+                for (auto & options : all_options)
+                {
+                    if (!options.names.front().starts_with('-'))
+                    {
+                        m_arguments.emplace_back(PositionalArgument(std::move(options)));
+                    }
+                    else
+                    {
+                        m_arguments.emplace_back(OptionalArgument(std::move(options)));
+                    }
+                }
+            }
+
+            auto add_mutually_exclusive_group()
+            {
+                return MutuallyExclusiveGroup(m_arguments, m_version);
+            }
+
+            auto prog(std::string prog) -> ArgumentParser &&
+            {
+                m_prog = std::move(prog);
+
+                return std::move(*this);
+            }
+
+            auto usage(std::string usage) -> ArgumentParser &&
+            {
+                m_usage = std::move(usage);
+
+                return std::move(*this);
+            }
+
+            auto description(std::string description) -> ArgumentParser &&
+            {
+                m_description = std::move(description);
+
+                return std::move(*this);
+            }
+
+            auto epilog(std::string epilog) -> ArgumentParser &&
+            {
+                m_epilog = std::move(epilog);
+
+                return std::move(*this);
+            }
+
+            auto parents(std::initializer_list<std::reference_wrapper<ArgumentParser const>> parents) -> ArgumentParser &&
+            {
+                m_cache.clear();
+
+                for (ArgumentParser const & parent : parents)
+                {
+                    for (auto const & argument : parent.m_arguments)
+                    {
+                        if (std::holds_alternative<OptionalArgument>(argument))
+                        {
+                            check_conflicts(m_arguments, cast_to_formattable(argument).get_names());
+                        }
+
+                        m_arguments.push_back(argument);
+                    }
+
+                    if (!m_version)
+                    {
+                        m_version = parent.m_version;
+                    }
+                }
+
+                return std::move(*this);
+            }
+
+            auto add_help(bool add) -> ArgumentParser &&
+            {
+                if (!add)
+                {
+                    (void) m_arguments.erase(m_arguments.begin());
+                    m_defaults.reset();
+                    m_flag_indices.reset();
+                    m_cache.clear();
+                }
+
+                return std::move(*this);
+            }
+
+            auto handle(Handle handle) -> ArgumentParser &&
+            {
+                m_handle = handle;
+
+                return std::move(*this);
+            }
+
+            auto memory_resource(std::pmr::memory_resource * resource) -> ArgumentParser &&
+            {
+                m_memory_resource = resource;
+
+                return std::move(*this);
+            }
+
+            auto sparse(bool sparse) -> ArgumentParser &&
+            {
+                m_sparse = sparse;
+                m_cache.clear();
+
+                return std::move(*this);
+            }
+
+            auto config_file(std::filesystem::path path) -> ArgumentParser &&
+            {
+                m_config_file = std::move(path);
+                reload_config_file();
+
+                return std::move(*this);
+            }
+
+            auto reload_config_file() -> void
+            {
+                if (!m_config_file)
+                {
+                    return;
+                }
+
+                m_config.reset();
+                m_config_error = nullptr;
+                m_cache.clear();
+
+                try
+                {
+                    m_config = std::make_shared<ConfigFile const>(*m_config_file);
+                }
+                catch (parsing_error const &)
+                {
+                    m_config_error = std::current_exception();
+                }
+            }
+
+            auto cache(std::size_t capacity) -> ArgumentParser &&
+            {
+                m_cache = Cache(capacity);
+
+                return std::move(*this);
+            }
+
+            auto format_usage() const -> std::string
+            {
+                return Formatter::format_usage(m_arguments | std::views::transform(cast_to_formattable), m_usage, m_prog);
+            }
+
+            auto format_help() const -> std::string
+            {
+                return Formatter::format_help(m_arguments | std::views::transform(cast_to_formattable), m_prog, m_usage, m_description, m_epilog);
+            }
+
+            auto format_version() const -> std::string
+            {
+                return Formatter::format_version(m_version, m_prog);
+            }
+
+            ArgumentParser()
+            {
+                add_argument("-h", "--help").action(help).help("show this help message and exit");
+            }
+
+        private:
+            static auto extract_filename(std::string_view path) -> std::string_view
+            {
+                if (auto path_separator = path.find_last_of("/\\"); path_separator != std::string_view::npos)
+                {
+                    return path.substr(path_separator + 1);
+                }
+
+                return path;
+            }
+
+            auto parse_and_handle(Tokens tokens) -> Parameters
+            {
+                auto * const resource = tokens.get_allocator().resource();
+                return parse_and_handle([&] { return std::move(tokens); }, resource);
+            }
+
+            auto parse_and_handle(std::invocable auto make_tokens, std::pmr::memory_resource * resource) -> Parameters
+            {
+                try
+                {
+                    return parse_args(make_tokens());
+                }
+                catch (HelpRequested const &)
+                {
+                    if (m_handle & Handle::help)
+                    {
+                        std::println("{}", format_help());
+                        std::exit(EXIT_SUCCESS);
+                    }
+
+                    return get_parameters(m_arguments | std::views::transform(cast_to_argument), resource);
+                }
+                catch (VersionRequested const &)
+                {
+                    if (m_handle & Handle::version)
+                    {
+                        std::println("{}", format_version());
+                        std::exit(EXIT_SUCCESS);
+                    }
+
+                    return get_parameters(m_arguments | std::views::transform(cast_to_argument), resource);
+                }
+                catch (parsing_error const & e)
+                {
+                    if (m_handle & Handle::errors)
+                    {
+                        std::println("{}", e.what());
+                        std::println("{}", format_help());
+                        std::exit(EXIT_FAILURE);
+                    }
+
+                    throw;
+                }
+            }
+
+            auto parse_args(Tokens tokens) -> Parameters
+            {
+                reset();
+
+                auto arguments = m_arguments | std::views::transform(cast_to_argument);
+
+                parse_optional_arguments(arguments, tokens);
+                parse_config_file(arguments, tokens.get_allocator().resource());
+                parse_environment(arguments, tokens.get_allocator().resource());
+                parse_positional_arguments(arguments, tokens);
+
+                consume_pseudo_arguments(tokens);
+
+                check_unrecognised_arguments(tokens);
+                check_excluded_arguments(arguments);
+                check_missing_arguments(arguments);
+
+                return get_parameters(arguments, tokens.get_allocator().resource());
+            }
+
+            struct FileStamp
+            {
+                std::filesystem::file_time_type write_time;
+                std::uintmax_t size;
+                std::size_t hash;
+
+                auto operator==(FileStamp const &) const -> bool = default;
+            };
+
+            static auto hash_lines(std::vector<std::string> const & lines) -> std::size_t
+            {
+                auto hash = std::size_t(lines.size());
+                for (auto const & line : lines)
+                {
+                    hash ^= std::hash<std::string>()(line) + std::size_t(0x9e3779b9) + (hash << 6) + (hash >> 2);
+                }
+                return hash;
+            }
+
+            static auto read_argument_file(std::filesystem::path const & path) -> std::vector<std::string>
+            {
+                auto file = std::ifstream(path);
+                if (!file)
+                {
+                    throw parsing_error(std::format("can't open '{}'", path.string()));
+                }
+
+                auto lines = std::vector<std::string>();
+                for (auto line = std::string(); std::getline(file, line);)
+                {
+                    lines.push_back(std::move(line));
+                }
+
+                return lines;
+            }
+
+            static auto get_tokens(std::ranges::input_range auto && args, std::pmr::memory_resource * resource) -> Tokens
+            {
+                auto tokens = Tokens(resource);
+                if constexpr (std::ranges::sized_range<decltype(args)>)
+                {
+                    tokens.reserve(static_cast<std::size_t>(std::ranges::size(args)));
+                }
+
+                for (auto const & arg : args)
+                {
+                    tokens.emplace_back(std::pmr::string(std::string_view(arg), resource));
+                }
+
+                return tokens;
+            }
+
+            static auto join(std::vector<std::string> const & strings, std::string_view separator) -> std::string
+            {
+                return join(strings | std::views::all, separator);
+            }
+
+            static auto join(std::ranges::view auto strings, std::string_view separator) -> std::string
             {
                 auto const joined = std::ranges::fold_left_first(strings, [=](auto l, auto const & r) { l += separator; l += r; return std::move(l); });
                 return joined.value_or(std::string());
             }
 
+            static auto get_environment() -> char const * const *
+            {
+#if defined(_WIN32)
+#pragma warning(suppress: 4996)
+                return _environ;
+#elif defined(__APPLE__)
+                return *_NSGetEnviron();
+#else
+                return environ;
+#endif
+            }
+
+            auto parse_config_file(std::ranges::view auto arguments, std::pmr::memory_resource * resource) const -> void
+            {
+                if (m_config_error)
+                {
+                    std::rethrow_exception(m_config_error);
+                }
+
+                if (!m_config)
+                {
+                    return;
+                }
+
+                auto const & config = *m_config;
+                auto const configurable = [](auto const & argument) { return argument.is_configurable(); };
+
+                auto dest_names = std::vector<std::string_view>();
+                for (auto & argument : arguments | std::views::filter(configurable))
+                {
+                    argument.parse_config(config, resource);
+                    dest_names.push_back(argument.get_dest_name());
+                }
+
+                std::ranges::sort(dest_names);
+
+                for (auto const key : config.keys())
+                {
+                    if (!std::ranges::binary_search(dest_names, key))
+                    {
+                        throw parsing_error(std::format("unrecognised key in '{}': {}", m_config_file->string(), key));
+                    }
+                }
+            }
+
+            static auto parse_environment(std::ranges::view auto arguments, std::pmr::memory_resource * resource) -> void
+            {
+                if (std::ranges::none_of(arguments, [](auto const & argument) { return argument.has_env(); }))
+                {
+                    return;
+                }
+
+                auto const environment = Environment(get_environment());
+
+                for (auto & argument : arguments | std::views::filter([](auto const & argument) { return argument.has_env(); }))
+                {
+                    argument.parse_environment(environment, resource);
+                }
+            }
+
             static auto parse_optional_arguments(std::ranges::view auto arguments, Tokens & tokens) -> void
             {
                 for (auto & argument : arguments
@@ -438,7 +2112,7 @@ namespace argparse
                     | std::views::filter(std::not_fn(&Token::m_consumed));
                 if (!unconsumed.empty())
                 {
-                    throw parsing_error(std::format("unrecognised arguments: {}", join(unconsumed | std::views::transform(&Token::m_token), " ")));
+                    throw parsing_error(std::format("unrecognised arguments: {}", join(unconsumed | std::views::transform([](auto const & token) { return std::string(token.m_token); }), " ")));
                 }
             }
 
@@ -481,18 +2155,68 @@ namespace argparse
                 }
             }
 
-            static auto get_parameters(std::ranges::view auto arguments) -> Parameters
+            auto get_parameters(std::ranges::view auto arguments, std::pmr::memory_resource * resource) -> Parameters
             {
-                auto result = Parameters();
+                auto result = m_sparse ? Parameters(resource, get_defaults()) : Parameters(resource);
+                result.m_flag_indices = get_flag_indices();
 
                 for (auto const & argument : arguments)
                 {
-                    result.insert(argument.get_dest_name(), argument.get_value());
+                    if (argument.is_flag())
+                    {
+                        result.insert_flag(std::any_cast<bool>(argument.get_value()));
+                    }
+                    else if (!m_sparse || argument.is_positional() || argument.is_present() || argument.is_overridden())
+                    {
+                        result.append(argument.get_dest_name(), argument.get_value());
+                    }
                 }
 
+                result.sort();
+
                 return result;
             }
 
+            auto get_defaults() -> std::shared_ptr<Parameters const>
+            {
+                if (!m_defaults || m_defaults_count != m_arguments.size())
+                {
+                    auto defaults = Parameters();
+
+                    for (auto const & argument : m_arguments | std::views::transform(cast_to_argument) | std::views::filter([](auto const & argument) { return !argument.is_positional() && !argument.is_flag(); }))
+                    {
+                        defaults.append(argument.get_dest_name(), argument.get_non_present_value());
+                    }
+
+                    defaults.sort();
+
+                    m_defaults = std::make_shared<Parameters const>(std::move(defaults));
+                    m_defaults_count = m_arguments.size();
+                }
+
+                return m_defaults;
+            }
+
+            auto get_flag_indices() -> std::shared_ptr<FlagIndices const>
+            {
+                if (!m_flag_indices || m_flag_indices_count != m_arguments.size())
+                {
+                    auto indices = FlagIndices();
+
+                    for (auto const & argument : m_arguments | std::views::transform(cast_to_argument) | std::views::filter([](auto const & argument) { return argument.is_flag(); }))
+                    {
+                        indices.emplace_back(argument.get_dest_name(), indices.size());
+                    }
+
+                    std::ranges::sort(indices);
+
+                    m_flag_indices = std::make_shared<FlagIndices const>(std::move(indices));
+                    m_flag_indices_count = m_arguments.size();
+                }
+
+                return m_flag_indices;
+            }
+
             static auto replace_prog(std::string text, OptString const & replacement) -> std::string
             {
                 if (!replacement)
@@ -513,75 +2237,372 @@ namespace argparse
         private:
             class MutuallyExclusiveGroup;
 
+            class Cache
+            {
+                public:
+                    explicit Cache(std::size_t capacity = 0)
+                      : m_capacity(capacity)
+                    {
+                        m_index.reserve(capacity);
+                    }
+
+                    Cache(Cache const & other)
+                      : Cache(other.m_capacity)
+                    {
+                    }
+
+                    Cache(Cache && other) noexcept = default;
+
+                    Cache & operator=(Cache const & other)
+                    {
+                        if (this != &other)
+                        {
+                            *this = Cache(other.m_capacity);
+                        }
+                        return *this;
+                    }
+
+                    Cache & operator=(Cache && other) noexcept = default;
+
+                    auto find(std::span<char const * const> args) -> std::shared_ptr<Parameters const>
+                    {
+                        if (m_capacity == 0)
+                        {
+                            return nullptr;
+                        }
+
+                        if (auto const it = m_index.find(hash(args)); it != m_index.end() && std::ranges::equal(it->second->args, args))
+                        {
+                            m_entries.splice(m_entries.begin(), m_entries, it->second);
+                            ++m_stats.hits;
+                            return it->second->parameters;
+                        }
+
+                        ++m_stats.misses;
+                        return nullptr;
+                    }
+
+                    auto insert(std::span<char const * const> args, std::shared_ptr<Parameters const> parameters) -> void
+                    {
+                        if (m_capacity == 0)
+                        {
+                            return;
+                        }
+
+                        auto const key = hash(args);
+
+                        if (auto const it = m_index.find(key); it != m_index.end())
+                        {
+                            m_entries.splice(m_entries.begin(), m_entries, it->second);
+                            it->second->args = args | std::ranges::to<std::vector<std::string>>();
+                            it->second->parameters = std::move(parameters);
+                            return;
+                        }
+
+                        if (m_entries.size() == m_capacity)
+                        {
+                            m_index.erase(m_entries.back().key);
+                            m_entries.pop_back();
+                        }
+
+                        m_entries.push_front(Entry{key, args | std::ranges::to<std::vector<std::string>>(), std::move(parameters)});
+                        m_index.emplace(key, m_entries.begin());
+                    }
+
+                    auto clear() -> void
+                    {
+                        m_entries.clear();
+                        m_index.clear();
+                    }
+
+                    auto get_stats() const -> CacheStats
+                    {
+                        return m_stats;
+                    }
+
+                private:
+                    struct Entry
+                    {
+                        std::size_t key;
+                        std::vector<std::string> args;
+                        std::shared_ptr<Parameters const> parameters;
+                    };
+
+                    static auto hash(std::span<char const * const> args) -> std::size_t
+                    {
+                        auto result = std::uint64_t(14695981039346656037u);
+                        for (auto const * arg : args)
+                        {
+                            for (auto const ch : std::string_view(arg))
+                            {
+                                result = (result ^ static_cast<unsigned char>(ch)) * 1099511628211u;
+                            }
+                            result = (result ^ 0xffu) * 1099511628211u;
+                        }
+                        return static_cast<std::size_t>(result);
+                    }
+
+                private:
+                    std::size_t m_capacity;
+                    std::list<Entry> m_entries;
+                    std::unordered_map<std::size_t, std::list<Entry>::iterator> m_index;
+                    CacheStats m_stats;
+            };
+
+            enum class Kind
+            {
+                unknown,
+                positional,
+                optional
+            };
+
+            template<FixedString ...Names>
+            static consteval auto get_kind() -> Kind
+            {
+                return std::array{Names.view()...}.front().starts_with('-')
+                    ? Kind::optional
+                    : Kind::positional;
+            }
+
+            template<FixedString ...Names>
+            static consteval auto check_names() -> void
+            {
+                static_assert(sizeof...(Names) > 0, "argument needs a name");
+                static_assert((!Names.view().empty() && ...), "argument names must not be empty");
+
+                if constexpr (get_kind<Names...>() == Kind::positional)
+                {
+                    static_assert(sizeof...(Names) == 1, "positional argument must have exactly one name");
+                }
+                else
+                {
+                    static_assert((Names.view().starts_with('-') && ...), "optional argument names must start with '-'");
+                    static_assert(((Names.view().size() > 1 && Names.view() != "--") && ...), "optional argument names must not consist of dashes only");
+                }
+            }
+
+            enum class JsonType
+            {
+                number,
+                boolean,
+                string
+            };
+
             class TypeHandler
             {
                 public:
                     virtual ~TypeHandler() = default;
 
-                    virtual auto from_string(std::string const & string) const -> std::any = 0;
+                    virtual auto from_string(std::string_view string) const -> std::expected<std::any, ConversionError> = 0;
                     virtual auto to_string(std::any const & value) const -> std::string = 0;
                     virtual auto compare(std::any const & lhs, std::any const & rhs) const -> bool = 0;
                     virtual auto transform(std::vector<std::any> const & values) const -> std::any = 0;
                     virtual auto append(std::any const & value, std::any & values) const -> void = 0;
                     virtual auto size(std::any const & value) const -> std::size_t = 0;
+                    virtual auto index(std::vector<std::any> const & values) const -> std::any = 0;
+                    virtual auto contains(std::any const & index, std::any const & value) const -> bool = 0;
+                    virtual auto is_equal(std::any const & lhs, std::any const & rhs) const -> bool = 0;
+                    virtual auto holds(std::any const & value) const -> bool = 0;
+                    virtual auto json_type() const -> JsonType = 0;
+                    virtual auto holds_vector(std::any const & value) const -> bool = 0;
+                    virtual auto write(std::any const & value, std::vector<char> & buffer) const -> void = 0;
+                    virtual auto write(std::any const & values, std::size_t index, std::vector<char> & buffer) const -> void = 0;
+                    virtual auto default_choices() const -> std::vector<std::any> = 0;
             };
 
             template<typename T>
             class TypeHandlerT final : public TypeHandler
             {
+                private:
+                    static constexpr auto has_choices_index = std::totally_ordered<T> && !std::floating_point<T> && !std::is_same_v<T, bool> && requires { requires Converter<T>::default_equality; };
+
                 public:
-                    auto from_string(std::string const & string) const -> std::any override
+                    static auto instance() -> TypeHandler const *
+                    {
+                        static auto const handler = TypeHandlerT<T>();
+                        return &handler;
+                    }
+
+                    auto from_string(std::string_view string) const -> std::expected<std::any, ConversionError> override
                     {
                         if constexpr (std::is_same_v<std::string, T>)
                         {
-                            return std::any(string);
+                            return std::any(std::string(string));
+                        }
+                        else if constexpr (expected_converter<T>)
+                        {
+                            auto const conv = Converter<T>();
+                            if (auto value = conv.from_string(string); value.has_value())
+                            {
+                                return std::any(*std::move(value));
+                            }
+                            else
+                            {
+                                return std::unexpected(std::move(value).error());
+                            }
                         }
                         else
                         {
-                            if (auto const optvalue = argparse::from_string<T>(string); optvalue.has_value())
+                            if (auto const optvalue = argparse::from_string<T>(std::string(string)); optvalue.has_value())
                             {
                                 return std::any(*optvalue);
                             }
                             else
                             {
-                                return std::any();
+                                return std::unexpected(ConversionError());
                             }
                         }
                     }
 
-                    auto to_string(std::any const & value) const -> std::string override
+                    auto default_choices() const -> std::vector<std::any> override
+                    {
+                        if constexpr (requires { Converter<T>::choices(); })
+                        {
+                            return Converter<T>::choices();
+                        }
+                        else
+                        {
+                            return {};
+                        }
+                    }
+
+                    auto to_string(std::any const & value) const -> std::string override
+                    {
+                        if constexpr (std::is_same_v<std::string, T>)
+                        {
+                            return "\"" + std::any_cast<std::string>(value) + "\"";
+                        }
+                        else
+                        {
+                            return argparse::to_string(std::any_cast<T>(value));
+                        }
+                    }
+
+                    auto compare(std::any const & lhs, std::any const & rhs) const -> bool override
+                    {
+                        return argparse::are_equal(std::any_cast<T>(lhs), std::any_cast<T>(rhs));
+                    }
+
+                    auto transform(std::vector<std::any> const & values) const -> std::any override
+                    {
+                        return std::any(
+                            values
+                            | std::views::transform([](auto const & value) { return std::any_cast<T>(value); })
+                            | std::ranges::to<std::vector>());
+                    }
+
+                    auto append(std::any const & value, std::any & values) const -> void override
+                    {
+                        std::any_cast<std::vector<T> &>(values).push_back(std::any_cast<T>(value));
+                    }
+
+                    auto size(std::any const & value) const -> std::size_t override
+                    {
+                        return std::any_cast<std::vector<T> const &>(value).size();
+                    }
+
+                    auto index(std::vector<std::any> const & values) const -> std::any override
+                    {
+                        if constexpr (has_choices_index)
+                        {
+                            auto sorted = values
+                                | std::views::transform([](auto const & value) { return std::any_cast<T>(value); })
+                                | std::ranges::to<std::vector>();
+                            std::ranges::sort(sorted);
+                            return std::any(std::move(sorted));
+                        }
+                        else
+                        {
+                            return std::any();
+                        }
+                    }
+
+                    auto contains(std::any const & index, std::any const & value) const -> bool override
+                    {
+                        if constexpr (has_choices_index)
+                        {
+                            return std::ranges::binary_search(std::any_cast<std::vector<T> const &>(index), std::any_cast<T const &>(value));
+                        }
+                        else
+                        {
+                            return false;
+                        }
+                    }
+
+                    auto is_equal(std::any const & lhs, std::any const & rhs) const -> bool override
+                    {
+                        if (lhs.type() != rhs.type())
+                        {
+                            return false;
+                        }
+
+                        if (lhs.type() == typeid(T))
+                        {
+                            return argparse::are_equal(std::any_cast<T const &>(lhs), std::any_cast<T const &>(rhs));
+                        }
+
+                        if (lhs.type() == typeid(std::vector<T>))
+                        {
+                            return std::ranges::equal(std::any_cast<std::vector<T> const &>(lhs), std::any_cast<std::vector<T> const &>(rhs), [](T const & l, T const & r) { return argparse::are_equal(l, r); });
+                        }
+
+                        return false;
+                    }
+
+                    auto holds(std::any const & value) const -> bool override
                     {
-                        if constexpr (std::is_same_v<std::string, T>)
+                        return value.type() == typeid(T);
+                    }
+
+                    auto json_type() const -> JsonType override
+                    {
+                        if constexpr (std::is_same_v<T, bool>)
                         {
-                            return "\"" + std::any_cast<std::string>(value) + "\"";
+                            return JsonType::boolean;
+                        }
+                        else if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, char> && !std::is_same_v<T, signed char> && !std::is_same_v<T, unsigned char>)
+                        {
+                            return JsonType::number;
                         }
                         else
                         {
-                            return argparse::to_string(std::any_cast<T>(value));
+                            return JsonType::string;
                         }
                     }
 
-                    auto compare(std::any const & lhs, std::any const & rhs) const -> bool override
+                    auto holds_vector(std::any const & value) const -> bool override
                     {
-                        return argparse::are_equal(std::any_cast<T>(lhs), std::any_cast<T>(rhs));
+                        return value.type() == typeid(std::vector<T>);
                     }
 
-                    auto transform(std::vector<std::any> const & values) const -> std::any override
+                    auto write(std::any const & value, std::vector<char> & buffer) const -> void override
                     {
-                        return std::any(
-                            values
-                            | std::views::transform([](auto const & value) { return std::any_cast<T>(value); })
-                            | std::ranges::to<std::vector>());
+                        write_value(std::any_cast<T const &>(value), buffer);
                     }
 
-                    auto append(std::any const & value, std::any & values) const -> void override
+                    auto write(std::any const & values, std::size_t index, std::vector<char> & buffer) const -> void override
                     {
-                        std::any_cast<std::vector<T> &>(values).push_back(std::any_cast<T>(value));
+                        write_value(std::any_cast<std::vector<T> const &>(values)[index], buffer);
                     }
 
-                    auto size(std::any const & value) const -> std::size_t override
+                private:
+                    static auto write_value(T const & value, std::vector<char> & buffer) -> void
                     {
-                        return std::any_cast<std::vector<T> const &>(value).size();
+                        if constexpr (std::is_same_v<std::string, T>)
+                        {
+                            buffer.insert(buffer.end(), value.begin(), value.end());
+                        }
+                        else if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char> && !std::is_same_v<T, signed char> && !std::is_same_v<T, unsigned char>)
+                        {
+                            auto chars = std::array<char, 128>();
+                            auto const result = std::to_chars(chars.data(), chars.data() + chars.size(), value);
+                            buffer.insert(buffer.end(), chars.data(), result.ptr);
+                        }
+                        else
+                        {
+                            auto const string = argparse::to_string(value);
+                            buffer.insert(buffer.end(), string.begin(), string.end());
+                        }
                     }
             };
 
@@ -589,16 +2610,27 @@ namespace argparse
             {
                 public:
                     virtual auto parse_tokens(Tokens & tokens) -> void = 0;
+                    virtual auto parse_environment(Environment const & environment, std::pmr::memory_resource * resource) -> void = 0;
+                    virtual auto parse_config(ConfigFile const & config, std::pmr::memory_resource * resource) -> void = 0;
+                    virtual auto reset() -> void = 0;
                     virtual auto is_positional() const -> bool = 0;
                     virtual auto is_present() const -> bool = 0;
+                    virtual auto is_overridden() const -> bool = 0;
                     virtual auto is_required() const -> bool = 0;
+                    virtual auto is_configurable() const -> bool = 0;
+                    virtual auto has_env() const -> bool = 0;
                     virtual auto is_mutually_exclusive() const -> bool = 0;
                     virtual auto is_mutually_exclusive_with(Argument const & other) const -> bool = 0;
                     virtual auto expects_argument() const -> bool = 0;
                     virtual auto has_value() const -> bool = 0;
                     virtual auto get_value() const -> std::any = 0;
-                    virtual auto get_dest_name() const -> std::string = 0;
-                    virtual auto get_joined_names() const -> std::string = 0;
+                    virtual auto get_non_present_value() const -> std::any = 0;
+                    virtual auto is_flag() const -> bool = 0;
+                    virtual auto unparse(std::any const & value, Argv & argv) const -> bool = 0;
+                    virtual auto canonicalise(std::any const & value, std::vector<char> & buffer) const -> bool = 0;
+                    virtual auto get_dest_name() const -> std::string const & = 0;
+                    virtual auto get_type_handler() const -> TypeHandler const * = 0;
+                    virtual auto get_joined_names() const -> std::string const & = 0;
 
                 protected:
                     ~Argument() = default;
@@ -618,8 +2650,8 @@ namespace argparse
                     virtual auto has_nargs_number() const -> bool = 0;
                     virtual auto has_choices() const -> bool = 0;
                     virtual auto expects_argument() const -> bool = 0;
-                    virtual auto get_joined_choices(std::string_view separator) const -> std::string = 0;
-                    virtual auto get_metavar_name() const -> std::string = 0;
+                    virtual auto get_joined_choices() const -> std::string const & = 0;
+                    virtual auto get_metavar_name() const -> std::string const & = 0;
                     virtual auto get_nargs_number() const -> std::size_t = 0;
                     virtual auto get_nargs_option() const -> Nargs = 0;
 
@@ -633,6 +2665,7 @@ namespace argparse
                 std::string help;
                 std::string metavar;
                 std::string dest;
+                std::string env;
                 Action action = store;
                 std::any const_;
                 std::any default_;
@@ -640,7 +2673,7 @@ namespace argparse
                 std::vector<std::any> choices;
                 std::optional<std::variant<std::size_t, Nargs>> nargs;
                 MutuallyExclusiveGroup const * mutually_exclusive_group = nullptr;
-                std::unique_ptr<TypeHandler> type_handler = std::make_unique<TypeHandlerT<std::string>>();
+                TypeHandler const * type_handler = TypeHandlerT<std::string>::instance();
             };
 
             class ArgumentImpl;
@@ -892,8 +2925,7 @@ namespace argparse
                         {
                             if (!value.has_value())
                             {
-                                auto const values = impl.consume_tokens(std::views::single(Token{val}));
-                                value = impl.get_transformed(values);
+                                value = impl.get_transformed(std::vector<std::any>{impl.process_token(val)});
                             }
                             else
                             {
@@ -921,93 +2953,125 @@ namespace argparse
             {
                 public:
                     explicit ArgumentImpl(Options options)
-                      : m_options(std::move(options))
+                      : m_definition(std::make_shared<Definition const>(std::move(options)))
                     {
                     }
 
                     auto get_name() const -> std::string const &
                     {
-                        return m_options.names.front();
+                        return m_definition->options.names.front();
                     }
 
                     auto get_names() const -> std::vector<std::string> const &
                     {
-                        return m_options.names;
+                        return m_definition->options.names;
+                    }
+
+                    auto get_joined_names() const -> std::string const &
+                    {
+                        return m_definition->joined_names;
+                    }
+
+                    auto get_dest_name() const -> std::string const &
+                    {
+                        return m_definition->dest_name;
+                    }
+
+                    auto get_metavar_name() const -> std::string const &
+                    {
+                        return m_definition->metavar_name;
                     }
 
-                    auto get_joined_names() const -> std::string
+                    auto get_env() const -> std::string const &
                     {
-                        return join(m_options.names, "/");
+                        return m_definition->options.env;
+                    }
+
+                    auto get_type_handler() const -> TypeHandler const *
+                    {
+                        return m_definition->options.type_handler;
                     }
 
                     auto has_nargs() const -> bool
                     {
-                        return m_options.nargs.has_value();
+                        return m_definition->options.nargs.has_value();
                     }
 
                     auto has_nargs_number() const -> bool
                     {
-                        return std::holds_alternative<std::size_t>(*m_options.nargs);
+                        return std::holds_alternative<std::size_t>(*m_definition->options.nargs);
                     }
 
                     auto get_nargs_number() const -> std::size_t
                     {
-                        return std::get<std::size_t>(*m_options.nargs);
+                        return std::get<std::size_t>(*m_definition->options.nargs);
                     }
 
                     auto get_nargs_option() const -> Nargs
                     {
-                        return std::get<Nargs>(*m_options.nargs);
+                        return std::get<Nargs>(*m_definition->options.nargs);
                     }
 
                     auto is_mutually_exclusive() const -> bool
                     {
-                        return m_options.mutually_exclusive_group != nullptr;
+                        return m_definition->options.mutually_exclusive_group != nullptr;
                     }
 
                     auto is_mutually_exclusive_with(ArgumentImpl const & other) const -> bool
                     {
-                        return (m_options.mutually_exclusive_group != nullptr) && (m_options.mutually_exclusive_group == other.m_options.mutually_exclusive_group);
+                        return (m_definition->options.mutually_exclusive_group != nullptr) && (m_definition->options.mutually_exclusive_group == other.m_definition->options.mutually_exclusive_group);
                     }
 
                     auto expects_argument() const -> bool
                     {
-                        return m_options.action == store || m_options.action == append;
+                        return m_definition->options.action == store || m_definition->options.action == append;
                     }
 
                     auto get_help() const -> std::string const &
                     {
-                        return m_options.help;
+                        return m_definition->options.help;
                     }
 
                     auto get_default() const -> std::any const &
                     {
-                        return m_options.default_;
+                        return m_definition->options.default_;
                     }
 
                     auto get_const() const -> std::any const &
                     {
-                        return m_options.const_;
+                        return m_definition->options.const_;
                     }
 
                     auto get_metavar() const -> std::string const &
                     {
-                        return m_options.metavar;
+                        return m_definition->options.metavar;
                     }
 
                     auto get_dest() const -> std::string const &
                     {
-                        return m_options.dest;
+                        return m_definition->options.dest;
                     }
 
                     auto get_required() const -> bool
                     {
-                        return m_options.required;
+                        return m_definition->options.required;
+                    }
+
+                    auto is_flag() const -> bool
+                    {
+                        auto const action = m_definition->options.action;
+                        return action == store_true || action == store_false || action == argparse::help || action == argparse::version;
+                    }
+
+                    auto is_configurable() const -> bool
+                    {
+                        auto const action = m_definition->options.action;
+                        return action != argparse::help && action != argparse::version;
                     }
 
                     auto get_action() const -> std::variant<StoreAction, StoreConstAction, StoreTrueAction, StoreFalseAction, HelpAction, VersionAction, CountAction, AppendAction>
                     {
-                        switch (m_options.action)
+                        switch (m_definition->options.action)
                         {
                             case store:
                                 return StoreAction();
@@ -1032,18 +3096,18 @@ namespace argparse
 
                     auto has_choices() const -> bool
                     {
-                        return !m_options.choices.empty();
+                        return !m_definition->options.choices.empty();
                     }
 
-                    auto get_joined_choices(std::string_view separator) const -> std::string
+                    auto get_joined_choices() const -> std::string const &
                     {
-                        return join(m_options.choices | std::views::transform([&](auto const & choice) { return m_options.type_handler->to_string(choice); }), separator);
+                        return m_definition->joined_choices;
                     }
 
                     auto parse_arguments(std::ranges::view auto tokens) const -> std::any
                     {
                         auto const values = consume_tokens(tokens);
-                        return m_options.type_handler->transform(values);
+                        return m_definition->options.type_handler->transform(values);
                     }
 
                     auto consume_token(Token & token) const -> std::any
@@ -1052,15 +3116,19 @@ namespace argparse
                         return process_token(token.m_token);
                     }
 
-                    auto process_token(std::string const & token) const -> std::any
+                    auto process_token(std::string_view token) const -> std::any
                     {
-                        auto const value = m_options.type_handler->from_string(token);
+                        auto value = m_definition->options.type_handler->from_string(token);
                         if (!value.has_value())
                         {
+                            if (auto const & message = value.error().message; !message.empty())
+                            {
+                                throw parsing_error(std::format("argument {}: invalid value: '{}' ({})", get_joined_names(), token, message));
+                            }
                             throw parsing_error(std::format("argument {}: invalid value: '{}'", get_joined_names(), token));
                         }
-                        check_choices(value);
-                        return value;
+                        check_choices(*value);
+                        return *std::move(value);
                     }
 
                     auto consume_tokens(std::ranges::view auto tokens) const -> std::vector<std::any>
@@ -1078,47 +3146,315 @@ namespace argparse
 
                     auto check_choices(std::any const & value) const -> void
                     {
-                        if (m_options.choices.empty())
+                        if (m_definition->options.choices.empty())
                         {
                             return;
                         }
 
-                        if (!std::ranges::any_of(
-                            m_options.choices,
-                            [&](auto const & rhs) { return m_options.type_handler->compare(value, rhs); }))
+                        if (!is_valid_choice(value))
                         {
                             auto const message = std::format(
                                 "argument {}: invalid choice: {} (choose from {})",
                                 get_joined_names(),
-                                m_options.type_handler->to_string(value),
-                                get_joined_choices(", "));
+                                m_definition->options.type_handler->to_string(value),
+                                m_definition->listed_choices);
                             throw parsing_error(message);
                         }
                     }
 
                     auto get_transformed(std::vector<std::any> const & values) const -> std::any
                     {
-                        return m_options.type_handler->transform(values);
+                        return m_definition->options.type_handler->transform(values);
                     }
 
                     auto get_size(std::any const & value) const -> std::size_t
                     {
-                        return m_options.type_handler->size(value);
+                        return m_definition->options.type_handler->size(value);
                     }
 
                     auto append_value(std::any const & value, std::any & values) const -> void
                     {
-                        m_options.type_handler->append(value, values);
+                        m_definition->options.type_handler->append(value, values);
                     }
 
-                    static auto is_negative_number(std::string const & token) -> bool
+                    static auto is_negative_number(std::string_view token) -> bool
                     {
-                        auto const parsed = from_string<double>(token);
+                        auto const parsed = from_string<double>(std::string(token));
                         return parsed.has_value();
                     }
 
+                    auto unparse(std::any const & value, Argv & argv) const -> bool
+                    {
+                        auto const & options = m_definition->options;
+                        auto const * const handler = options.type_handler;
+
+                        auto const is_default = options.default_.has_value() && is_same_value(value, options.default_);
+
+                        if (Definition::is_positional(options))
+                        {
+                            auto const is_optional = has_nargs() && !has_nargs_number() && get_nargs_option() != one_or_more;
+                            return value.has_value() && !(is_optional && is_default) && unparse_values(value, argv);
+                        }
+
+                        if (!value.has_value() || (is_default && !options.required))
+                        {
+                            return false;
+                        }
+
+                        auto const & name = get_name();
+
+                        switch (options.action)
+                        {
+                            case store:
+                                argv.push(name);
+                                if (!has_nargs())
+                                {
+                                    argv.push(handler, value);
+                                    if (argv.back().starts_with('-') && !is_negative_number(argv.back()))
+                                    {
+                                        argv.join_last(name.starts_with("--") ? "=" : "");
+                                    }
+                                    return false;
+                                }
+                                if (!has_nargs_number() && get_nargs_option() == zero_or_one && options.const_.has_value() && is_same_value(value, options.const_))
+                                {
+                                    return true;
+                                }
+                                if (unparse_values(value, argv))
+                                {
+                                    throw type_error(std::format("argument {}: values starting with '-' cannot be unparsed", get_joined_names()));
+                                }
+                                return !has_nargs_number();
+                            case store_const:
+                                argv.push(name);
+                                return false;
+                            case store_true:
+                            case store_false:
+                                if (std::any_cast<bool>(value) == (options.action == store_true))
+                                {
+                                    argv.push(name);
+                                }
+                                return false;
+                            case count:
+                                for (auto i = 0; i < std::any_cast<int>(value); ++i)
+                                {
+                                    argv.push(name);
+                                }
+                                return false;
+                            case append:
+                                for (auto i = std::size_t(0); i != handler->size(value); ++i)
+                                {
+                                    argv.push(name);
+                                    argv.push(handler, value, i);
+                                    if (argv.back().starts_with('-') && !is_negative_number(argv.back()))
+                                    {
+                                        argv.join_last(name.starts_with("--") ? "=" : "");
+                                    }
+                                }
+                                return false;
+                            case argparse::help:
+                            case argparse::version:
+                                return false;
+                        }
+
+                        std::unreachable();
+                    }
+
+                    auto canonicalise(std::any const & value, std::any const & non_present_value, std::vector<char> & buffer) const -> bool
+                    {
+                        auto const & options = m_definition->options;
+                        auto const * const handler = options.type_handler;
+
+                        if (options.action == argparse::help || options.action == argparse::version || is_same_value(value, non_present_value) || (options.default_.has_value() && is_same_value(value, options.default_)))
+                        {
+                            return false;
+                        }
+
+                        auto const write_size = [&](std::size_t offset, std::uint64_t size)
+                        {
+                            for (auto i = std::size_t(0); i != sizeof(size); ++i)
+                            {
+                                buffer[offset + i] = static_cast<char>((size >> (8 * i)) & 0xff);
+                            }
+                        };
+
+                        auto const field = [&](auto write)
+                        {
+                            auto const offset = buffer.size();
+                            buffer.resize(offset + sizeof(std::uint64_t));
+                            write();
+                            write_size(offset, buffer.size() - offset - sizeof(std::uint64_t));
+                        };
+
+                        field([&] { buffer.insert(buffer.end(), get_dest_name().begin(), get_dest_name().end()); });
+
+                        if (!value.has_value())
+                        {
+                            buffer.push_back('n');
+                        }
+                        else if (auto const * const flag = std::any_cast<bool>(&value); flag != nullptr && !handler->holds(value))
+                        {
+                            buffer.push_back('b');
+                            field([&] { buffer.push_back(*flag ? '1' : '0'); });
+                        }
+                        else if (value.type() == typeid(int) && !handler->holds(value))
+                        {
+                            buffer.push_back('i');
+                            field([&] { TypeHandlerT<int>::instance()->write(value, buffer); });
+                        }
+                        else if (handler->holds(value))
+                        {
+                            buffer.push_back('s');
+                            field([&] { handler->write(value, buffer); });
+                        }
+                        else if (handler->holds_vector(value))
+                        {
+                            auto const size = handler->size(value);
+                            buffer.push_back('v');
+                            buffer.resize(buffer.size() + sizeof(std::uint64_t));
+                            write_size(buffer.size() - sizeof(std::uint64_t), size);
+                            for (auto i = std::size_t(0); i != size; ++i)
+                            {
+                                field([&] { handler->write(value, i, buffer); });
+                            }
+                        }
+                        else
+                        {
+                            throw type_error(std::format("cannot fingerprint argument '{}' of type '{}'", get_dest_name(), value.type().name()));
+                        }
+
+                        return true;
+                    }
+
                 private:
-                    Options m_options;
+                    auto is_same_value(std::any const & lhs, std::any const & rhs) const -> bool
+                    {
+                        if (!lhs.has_value() || !rhs.has_value())
+                        {
+                            return lhs.has_value() == rhs.has_value();
+                        }
+
+                        if (lhs.type() != rhs.type())
+                        {
+                            return false;
+                        }
+
+                        if (lhs.type() == typeid(bool))
+                        {
+                            return std::any_cast<bool>(lhs) == std::any_cast<bool>(rhs);
+                        }
+
+                        if (lhs.type() == typeid(int) && !m_definition->options.type_handler->holds(lhs))
+                        {
+                            return std::any_cast<int>(lhs) == std::any_cast<int>(rhs);
+                        }
+
+                        return m_definition->options.type_handler->is_equal(lhs, rhs);
+                    }
+
+                    auto unparse_values(std::any const & value, Argv & argv) const -> bool
+                    {
+                        auto const * const handler = m_definition->options.type_handler;
+                        auto needs_separator = false;
+
+                        if (!has_nargs() || (!has_nargs_number() && get_nargs_option() == zero_or_one))
+                        {
+                            argv.push(handler, value);
+                            return argv.back().starts_with('-') && !is_negative_number(argv.back());
+                        }
+
+                        for (auto i = std::size_t(0); i != handler->size(value); ++i)
+                        {
+                            argv.push(handler, value, i);
+                            needs_separator = needs_separator || (argv.back().starts_with('-') && !is_negative_number(argv.back()));
+                        }
+
+                        return needs_separator;
+                    }
+
+                    auto is_valid_choice(std::any const & value) const -> bool
+                    {
+                        if (m_definition->choices_index.has_value())
+                        {
+                            return m_definition->options.type_handler->contains(m_definition->choices_index, value);
+                        }
+
+                        return std::ranges::any_of(
+                            m_definition->options.choices,
+                            [&](auto const & rhs) { return m_definition->options.type_handler->compare(value, rhs); });
+                    }
+
+                private:
+                    struct Definition
+                    {
+                        explicit Definition(Options opts)
+                          : options(std::move(opts))
+                          , choices_index(options.type_handler->index(options.choices))
+                          , joined_choices(join_choices(options, ","))
+                          , listed_choices(join_choices(options, ", "))
+                          , joined_names(join(options.names, "/"))
+                          , dest_name(derive_dest_name(options))
+                          , metavar_name(derive_metavar_name(options, dest_name))
+                        {
+                        }
+
+                        static auto is_positional(Options const & options) -> bool
+                        {
+                            return !options.names.front().starts_with('-');
+                        }
+
+                        static auto derive_dest_name(Options const & options) -> std::string
+                        {
+                            if (is_positional(options))
+                            {
+                                return options.names.front();
+                            }
+
+                            if (!options.dest.empty())
+                            {
+                                return options.dest;
+                            }
+
+                            auto const it = std::ranges::find_if(options.names, [](auto const & name) { return name.starts_with("--"); });
+                            auto dest = it != options.names.end() ? it->substr(2) : options.names.front().substr(1);
+
+                            std::ranges::replace(dest, '-', '_');
+
+                            return dest;
+                        }
+
+                        static auto derive_metavar_name(Options const & options, std::string const & dest_name) -> std::string
+                        {
+                            if (!options.metavar.empty())
+                            {
+                                return options.metavar;
+                            }
+
+                            auto metavar = dest_name;
+
+                            if (!is_positional(options))
+                            {
+                                std::ranges::for_each(metavar, [](char & ch) { ch = static_cast<char>(::toupper(ch)); });
+                            }
+
+                            return metavar;
+                        }
+
+                        static auto join_choices(Options const & options, std::string_view separator) -> std::string
+                        {
+                            return join(options.choices | std::views::transform([&](auto const & choice) { return options.type_handler->to_string(choice); }), separator);
+                        }
+
+                        Options options;
+                        std::any choices_index;
+                        std::string joined_choices;
+                        std::string listed_choices;
+                        std::string joined_names;
+                        std::string dest_name;
+                        std::string metavar_name;
+                    };
+
+                    std::shared_ptr<Definition const> m_definition;
             };
 
             class PositionalArgument final : public Argument, public Formattable
@@ -1190,8 +3526,10 @@ namespace argparse
                     {
                     }
 
+                    PositionalArgument(PositionalArgument const & other) = default;
                     PositionalArgument(PositionalArgument && other) noexcept = default;
 
+                    PositionalArgument & operator=(PositionalArgument const & other) = default;
                     PositionalArgument & operator=(PositionalArgument && other) noexcept = default;
 
                     auto parse_tokens(Tokens & tokens) -> void override
@@ -1218,16 +3556,32 @@ namespace argparse
                         }
                     }
 
-                    auto get_dest_name() const -> std::string override
+                    auto parse_environment(Environment const & /* environment */, std::pmr::memory_resource * /* resource */) -> void override
                     {
-                        return get_name();
                     }
 
-                    auto get_metavar_name() const -> std::string override
+                    auto parse_config(ConfigFile const & /* config */, std::pmr::memory_resource * /* resource */) -> void override
                     {
-                        return m_impl.get_metavar().empty()
-                            ? get_name()
-                            : m_impl.get_metavar();
+                    }
+
+                    auto reset() -> void override
+                    {
+                        m_value.reset();
+                    }
+
+                    auto get_dest_name() const -> std::string const & override
+                    {
+                        return m_impl.get_dest_name();
+                    }
+
+                    auto get_type_handler() const -> TypeHandler const * override
+                    {
+                        return m_impl.get_type_handler();
+                    }
+
+                    auto get_metavar_name() const -> std::string const & override
+                    {
+                        return m_impl.get_metavar_name();
                     }
 
                     auto has_value() const -> bool override
@@ -1257,6 +3611,41 @@ namespace argparse
                         return false;
                     }
 
+                    auto is_overridden() const -> bool override
+                    {
+                        return false;
+                    }
+
+                    auto is_configurable() const -> bool override
+                    {
+                        return false;
+                    }
+
+                    auto has_env() const -> bool override
+                    {
+                        return false;
+                    }
+
+                    auto get_non_present_value() const -> std::any override
+                    {
+                        return m_impl.get_default();
+                    }
+
+                    auto is_flag() const -> bool override
+                    {
+                        return m_impl.is_flag();
+                    }
+
+                    auto unparse(std::any const & value, Argv & argv) const -> bool override
+                    {
+                        return m_impl.unparse(value, argv);
+                    }
+
+                    auto canonicalise(std::any const & value, std::vector<char> & buffer) const -> bool override
+                    {
+                        return m_impl.canonicalise(value, get_non_present_value(), buffer);
+                    }
+
                     auto is_mutually_exclusive() const -> bool override
                     {
                         return m_impl.is_mutually_exclusive();
@@ -1277,7 +3666,7 @@ namespace argparse
                         return m_impl.expects_argument();
                     }
 
-                    auto get_joined_names() const -> std::string override
+                    auto get_joined_names() const -> std::string const & override
                     {
                         return m_impl.get_joined_names();
                     }
@@ -1312,9 +3701,9 @@ namespace argparse
                         return m_impl.has_choices();
                     }
 
-                    auto get_joined_choices(std::string_view separator) const -> std::string override
+                    auto get_joined_choices() const -> std::string const & override
                     {
-                        return m_impl.get_joined_choices(separator);
+                        return m_impl.get_joined_choices();
                     }
 
                     auto get_nargs_number() const -> std::size_t override
@@ -1375,7 +3764,7 @@ namespace argparse
 
                             if (auto const pos = token.m_token.find('='); pos != std::string::npos)
                             {
-                                return token.m_token.substr(pos + 1);
+                                return std::string(std::string_view(token.m_token).substr(pos + 1));
                             }
 
                             return "";
@@ -1397,40 +3786,94 @@ namespace argparse
 
                         if (pos == 1)
                         {
-                            token.m_consumed = true;
-                            return token.m_token.substr(pos);
+                            token.m_consumed = true;
+                            return std::string(std::string_view(token.m_token).substr(pos));
+                        }
+                        else
+                        {
+                            auto const value = std::string(std::string_view(token.m_token).substr(pos));
+                            token.m_token.resize(pos);
+                            return value;
+                        }
+                    }
+
+                    auto check_errors(std::string_view value, std::ranges::view auto tokens) const -> void
+                    {
+                        auto const action = m_impl.get_action();
+                        std::visit([&](auto const & ac) { ac.check_errors(m_impl, value, tokens); }, action);
+                    }
+
+                    auto assign_non_present_value() -> void
+                    {
+                        auto const action = m_impl.get_action();
+                        std::visit([&](auto const & ac) { ac.assign_non_present_value(m_impl, m_value); }, action);
+                    }
+
+                    auto parse_override(std::string_view value, std::pmr::memory_resource * resource) -> void
+                    {
+                        if (m_present)
+                        {
+                            return;
+                        }
+
+                        m_value.reset();
+                        m_overridden = true;
+
+                        if (!expects_argument() && !is_enabling(value))
+                        {
+                            assign_non_present_value();
+                            return;
                         }
-                        else
+
+                        if (std::holds_alternative<CountAction>(m_impl.get_action()))
                         {
-                            auto const value = token.m_token.substr(pos);
-                            token.m_token.resize(pos);
-                            return value;
+                            if (auto const count = from_string<int>(std::string(value)); count.has_value() && *count >= 0)
+                            {
+                                m_value = *count;
+                                return;
+                            }
+
+                            if (value != "true" && value != "yes" && value != "on")
+                            {
+                                throw parsing_error(std::format("argument {}: invalid value: '{}'", get_joined_names(), value));
+                            }
                         }
-                    }
 
-                    auto get_name_for_dest() const -> std::string
-                    {
-                        for (auto const & name : get_names())
+                        auto tokens = Tokens(resource);
+                        if (expects_argument())
                         {
-                            if (name.starts_with("--"))
+                            if (has_nargs())
+                            {
+                                auto const words = [&]
+                                {
+                                    try
+                                    {
+                                        return ShellWords(value);
+                                    }
+                                    catch (parsing_error const & e)
+                                    {
+                                        throw parsing_error(std::format("argument {}: {}", get_joined_names(), e.what()));
+                                    }
+                                }();
+                                for (auto const & word : words)
+                                {
+                                    tokens.push_back(Token{std::pmr::string(word, resource)});
+                                }
+                            }
+                            else
                             {
-                                return name.substr(2);
+                                tokens.push_back(Token{std::pmr::string(value, resource)});
                             }
                         }
 
-                        return get_name().substr(1);
+                        auto args = std::views::all(tokens);
+                        check_errors("", args);
+                        perform_action("", args);
                     }
 
-                    auto check_errors(std::string_view value, std::ranges::view auto tokens) const -> void
-                    {
-                        auto const action = m_impl.get_action();
-                        std::visit([&](auto const & ac) { ac.check_errors(m_impl, value, tokens); }, action);
-                    }
-
-                    auto assign_non_present_value() -> void
+                    static auto is_enabling(std::string_view value) -> bool
                     {
-                        auto const action = m_impl.get_action();
-                        std::visit([&](auto const & ac) { ac.assign_non_present_value(m_impl, m_value); }, action);
+                        return !value.empty() && value != "0" && value != "false" && value != "no" && value != "off";
                     }
 
                     static auto get_consumable(Tokens & tokens)
@@ -1455,8 +3898,10 @@ namespace argparse
                     {
                     }
 
+                    OptionalArgument(OptionalArgument const & other) = default;
                     OptionalArgument(OptionalArgument && other) noexcept = default;
 
+                    OptionalArgument & operator=(OptionalArgument const & other) = default;
                     OptionalArgument & operator=(OptionalArgument && other) noexcept = default;
 
                     auto parse_tokens(Tokens & tokens) -> void override
@@ -1493,32 +3938,42 @@ namespace argparse
                         }
                     }
 
-                    auto get_dest_name() const -> std::string override
+                    auto parse_environment(Environment const & environment, std::pmr::memory_resource * resource) -> void override
                     {
-                        if (auto const & dest = m_impl.get_dest(); !dest.empty())
+                        if (auto const value = environment.find(m_impl.get_env()))
                         {
-                            return dest;
+                            parse_override(*value, resource);
                         }
-
-                        auto dest = get_name_for_dest();
-
-                        std::ranges::replace(dest, '-', '_');
-
-                        return dest;
                     }
 
-                    auto get_metavar_name() const -> std::string override
+                    auto parse_config(ConfigFile const & config, std::pmr::memory_resource * resource) -> void override
                     {
-                        if (auto const & metavar = m_impl.get_metavar(); !metavar.empty())
+                        if (auto const value = config.find(get_dest_name()))
                         {
-                            return metavar;
+                            parse_override(*value, resource);
                         }
+                    }
+
+                    auto reset() -> void override
+                    {
+                        m_value.reset();
+                        m_present = false;
+                        m_overridden = false;
+                    }
 
-                        auto metavar = get_dest_name();
+                    auto get_dest_name() const -> std::string const & override
+                    {
+                        return m_impl.get_dest_name();
+                    }
 
-                        std::ranges::for_each(metavar, [](char & ch) { ch = static_cast<char>(::toupper(ch)); });
+                    auto get_type_handler() const -> TypeHandler const * override
+                    {
+                        return m_impl.get_type_handler();
+                    }
 
-                        return metavar;
+                    auto get_metavar_name() const -> std::string const & override
+                    {
+                        return m_impl.get_metavar_name();
                     }
 
                     auto has_value() const -> bool override
@@ -1546,6 +4001,44 @@ namespace argparse
                         return m_present;
                     }
 
+                    auto is_overridden() const -> bool override
+                    {
+                        return m_overridden;
+                    }
+
+                    auto is_configurable() const -> bool override
+                    {
+                        return m_impl.is_configurable();
+                    }
+
+                    auto has_env() const -> bool override
+                    {
+                        return !m_impl.get_env().empty();
+                    }
+
+                    auto get_non_present_value() const -> std::any override
+                    {
+                        auto value = std::any();
+                        auto const action = m_impl.get_action();
+                        std::visit([&](auto const & ac) { ac.assign_non_present_value(m_impl, value); }, action);
+                        return value;
+                    }
+
+                    auto is_flag() const -> bool override
+                    {
+                        return m_impl.is_flag();
+                    }
+
+                    auto unparse(std::any const & value, Argv & argv) const -> bool override
+                    {
+                        return m_impl.unparse(value, argv);
+                    }
+
+                    auto canonicalise(std::any const & value, std::vector<char> & buffer) const -> bool override
+                    {
+                        return m_impl.canonicalise(value, get_non_present_value(), buffer);
+                    }
+
                     auto is_mutually_exclusive() const -> bool override
                     {
                         return m_impl.is_mutually_exclusive();
@@ -1566,7 +4059,7 @@ namespace argparse
                         return m_impl.expects_argument();
                     }
 
-                    auto get_joined_names() const -> std::string override
+                    auto get_joined_names() const -> std::string const & override
                     {
                         return m_impl.get_joined_names();
                     }
@@ -1601,9 +4094,9 @@ namespace argparse
                         return m_impl.has_choices();
                     }
 
-                    auto get_joined_choices(std::string_view separator) const -> std::string override
+                    auto get_joined_choices() const -> std::string const & override
                     {
-                        return m_impl.get_joined_choices(separator);
+                        return m_impl.get_joined_choices();
                     }
 
                     auto get_nargs_number() const -> std::size_t override
@@ -1620,6 +4113,7 @@ namespace argparse
                     ArgumentImpl m_impl;
                     std::any m_value;
                     bool m_present = false;
+                    bool m_overridden = false;
             };
 
             using ArgumentVariant = std::variant<PositionalArgument, OptionalArgument>;
@@ -1635,7 +4129,7 @@ namespace argparse
                             return std::format("usage: {}", replace_prog(*usage, prog));
                         }
 
-                        return std::format("usage: {}{}{}", *prog, format_usage_optionals(arguments), format_usage_positionals(arguments));
+                        return std::format("usage:{}{}{}", prog ? " " + *prog : "", format_usage_optionals(arguments), format_usage_positionals(arguments));
                     }
 
                     static auto format_help(std::ranges::view auto arguments, OptString const & prog, OptString const & usage, OptString const & description, OptString const & epilog) -> std::string
@@ -1823,7 +4317,7 @@ namespace argparse
                     static auto format_arg(Formattable const & argument) -> std::string
                     {
                         return argument.has_choices()
-                            ? "{" + argument.get_joined_choices(",") + "}"
+                            ? "{" + argument.get_joined_choices() + "}"
                             : argument.get_metavar_name();
                     }
 
@@ -1875,11 +4369,19 @@ namespace argparse
                         return ArgumentBuilder(m_arguments, m_version, std::vector<std::string>{names...}, this);
                     }
 
+                    template<FixedString ...Names>
+                    decltype(auto) add_argument()
+                    {
+                        check_names<Names...>();
+                        return ArgumentBuilder<get_kind<Names...>()>(m_arguments, m_version, std::vector<std::string>{std::string(Names.view())...}, this);
+                    }
+
                 private:
                     Arguments & m_arguments;
                     OptString & m_version;
             };
 
+            template<Kind K = Kind::unknown>
             class ArgumentBuilder
             {
                 public:
@@ -1898,11 +4400,21 @@ namespace argparse
                             throw option_error("mutually exclusive arguments must be optional");
                         }
 
+                        if (!m_options.env.empty() && (m_options.action == argparse::help || m_options.action == argparse::version))
+                        {
+                            throw option_error("'env' is an invalid argument for help and version actions");
+                        }
+
                         if ((m_options.action == argparse::version) && m_options.help.empty())
                         {
                             m_options.help = "show program's version number and exit";
                         }
 
+                        if (!is_positional())
+                        {
+                            check_conflicts(m_arguments, m_options.names);
+                        }
+
                         if (is_positional())
                         {
                             m_arguments.emplace_back(PositionalArgument(std::move(m_options)));
@@ -1931,7 +4443,7 @@ namespace argparse
                         return *this;
                     }
 
-                    auto dest(std::string dest) -> ArgumentBuilder &
+                    auto dest(std::string dest) -> ArgumentBuilder & requires (K != Kind::positional)
                     {
                         if (is_positional())
                         {
@@ -1956,10 +4468,24 @@ namespace argparse
                     template<typename T>
                     auto type() -> ArgumentBuilder &
                     {
-                        if constexpr (!std::is_same_v<std::string, T>)
+                        m_options.type_handler = TypeHandlerT<T>::instance();
+                        if constexpr (requires { Converter<T>::choices(); })
+                        {
+                            if (m_options.choices.empty())
+                            {
+                                m_options.choices = Converter<T>::choices();
+                            }
+                        }
+                        return *this;
+                    }
+
+                    auto env(std::string env) -> ArgumentBuilder & requires (K != Kind::positional)
+                    {
+                        if (is_positional())
                         {
-                            m_options.type_handler = std::make_unique<TypeHandlerT<T>>();
+                            throw option_error("'env' is an invalid argument for positionals");
                         }
+                        m_options.env = std::move(env);
                         return *this;
                     }
 
@@ -1969,7 +4495,7 @@ namespace argparse
                         return *this;
                     }
 
-                    auto required(bool required) -> ArgumentBuilder &
+                    auto required(bool required) -> ArgumentBuilder & requires (K != Kind::positional)
                     {
                         if (is_positional())
                         {
@@ -2049,11 +4575,346 @@ namespace argparse
                     Options m_options;
             };
 
+            static auto is_positional(ArgSpec const & spec) -> bool
+            {
+                return !spec.names.front().starts_with('-');
+            }
+
+            static auto check_spec(ArgSpec const & spec) -> void
+            {
+                if (spec.names.front().empty())
+                {
+                    throw option_error("argument needs a name");
+                }
+
+                if (!is_positional(spec) && std::ranges::any_of(spec.names, [](auto name) { return name == "-" || name == "--"; }))
+                {
+                    throw option_error(std::format("argument {}: optional argument names must not consist of dashes only", spec.names.front()));
+                }
+
+                if (is_positional(spec))
+                {
+                    if (!spec.names.back().empty())
+                    {
+                        throw option_error(std::format("argument {}: positional argument must have exactly one name", spec.names.front()));
+                    }
+
+                    if (!spec.dest.empty())
+                    {
+                        throw option_error("'dest' is an invalid argument for positionals");
+                    }
+
+                    if (spec.required)
+                    {
+                        throw option_error("'required' is an invalid argument for positionals");
+                    }
+                }
+                else if (!spec.names.back().empty() && !spec.names.back().starts_with('-'))
+                {
+                    throw option_error(std::format("argument {}: optional argument names must start with '-'", spec.names.back()));
+                }
+            }
+
+            auto check_specs(std::span<ArgSpec const> specs) const -> void
+            {
+                auto seen = std::vector<std::vector<std::string>>();
+                for (auto const & spec : specs | std::views::filter([](auto const & spec) { return !is_positional(spec); }))
+                {
+                    auto names = spec.names | std::views::filter([](auto name) { return !name.empty(); }) | std::views::transform([](auto name) { return std::string(name); }) | std::ranges::to<std::vector>();
+                    check_conflicts(m_arguments, names);
+                    for (auto const & existing : seen)
+                    {
+                        check_conflicts(existing, names);
+                    }
+
+                    if (spec.action == argparse::version && spec.version.empty() && !m_version && std::ranges::none_of(specs, [](auto const & other) { return !other.version.empty(); }))
+                    {
+                        throw option_error(std::format("argument {}: 'version' action requires a version", join(names, "/")));
+                    }
+
+                    seen.push_back(std::move(names));
+                }
+            }
+
+            static auto get_options(ArgSpec const & spec) -> Options
+            {
+                auto options = Options();
+                options.names = spec.names | std::views::filter([](auto name) { return !name.empty(); }) | std::views::transform([](auto name) { return std::string(name); }) | std::ranges::to<std::vector>();
+                options.help = spec.action == argparse::version && spec.help.empty() ? "show program's version number and exit" : std::string(spec.help);
+                options.metavar = spec.metavar;
+                options.dest = spec.dest;
+                options.action = spec.action;
+                options.required = spec.required;
+                options.nargs = spec.nargs;
+
+                if (spec.type.handler != nullptr)
+                {
+                    options.type_handler = static_cast<TypeHandler const *>(spec.type.handler());
+                    options.choices = options.type_handler->default_choices();
+                }
+
+                auto const convert = [&](std::string_view string, std::string_view what)
+                {
+                    auto value = options.type_handler->from_string(string);
+                    if (!value.has_value())
+                    {
+                        throw option_error(std::format("argument {}: invalid {} value: '{}'", options.names.front(), what, string));
+                    }
+                    return *std::move(value);
+                };
+
+                if (!spec.choices.empty())
+                {
+                    options.choices = spec.choices | std::views::transform([&](auto choice) { return convert(choice, "choice"); }) | std::ranges::to<std::vector>();
+                }
+
+                if (spec.const_)
+                {
+                    options.const_ = convert(*spec.const_, "const");
+                }
+
+                if (spec.default_)
+                {
+                    options.default_ = convert(*spec.default_, "default");
+                }
+
+                return options;
+            }
+
+            static auto check_conflicts(Arguments const & arguments, std::vector<std::string> const & names) -> void
+            {
+                for (auto const & argument : arguments | std::views::filter([](auto const & av) { return std::holds_alternative<OptionalArgument>(av); }))
+                {
+                    check_conflicts(cast_to_formattable(argument).get_names(), names);
+                }
+            }
+
+            static auto check_conflicts(std::vector<std::string> const & existing, std::vector<std::string> const & names) -> void
+            {
+                auto const conflicting = names | std::views::filter([&](auto const & name) { return std::ranges::find(existing, name) != existing.end(); }) | std::ranges::to<std::vector>();
+
+                if (!conflicting.empty())
+                {
+                    throw option_error(std::format("argument {}: conflicting option string{}: {}", join(names, "/"), conflicting.size() == 1 ? "" : "s", join(conflicting, ", ")));
+                }
+            }
+
+            auto get_memory_resource() const -> std::pmr::memory_resource *
+            {
+                return m_memory_resource != nullptr ? m_memory_resource : std::pmr::get_default_resource();
+            }
+
             static auto cast_to_argument(ArgumentVariant & av) -> Argument &
             {
                 return std::visit([](auto & argument) -> Argument & { return argument; } , av);
             }
 
+            static auto write_json_string(std::string_view string, std::output_iterator<char> auto out) -> decltype(out)
+            {
+                auto const needs_escape = [](char ch) { return ch == '"' || ch == '\\' || static_cast<unsigned char>(ch) < 0x20 || static_cast<unsigned char>(ch) >= 0x80; };
+
+                *out++ = '"';
+                for (auto it = string.begin(); it != string.end();)
+                {
+                    auto const next = std::find_if(it, string.end(), needs_escape);
+                    out = std::ranges::copy(it, next, out).out;
+
+                    if (next == string.end())
+                    {
+                        break;
+                    }
+
+                    switch (*next)
+                    {
+                        case '"': out = std::ranges::copy(std::string_view("\\\""), out).out; break;
+                        case '\\': out = std::ranges::copy(std::string_view("\\\\"), out).out; break;
+                        case '\b': out = std::ranges::copy(std::string_view("\\b"), out).out; break;
+                        case '\f': out = std::ranges::copy(std::string_view("\\f"), out).out; break;
+                        case '\n': out = std::ranges::copy(std::string_view("\\n"), out).out; break;
+                        case '\r': out = std::ranges::copy(std::string_view("\\r"), out).out; break;
+                        case '\t': out = std::ranges::copy(std::string_view("\\t"), out).out; break;
+                        default:
+                        {
+                            if (static_cast<unsigned char>(*next) >= 0x80)
+                            {
+                                auto const length = get_utf8_sequence_length(std::string_view(next, string.end()));
+                                if (length == 0)
+                                {
+                                    out = std::ranges::copy(std::string_view("\\ufffd"), out).out;
+                                    it = std::next(next);
+                                }
+                                else
+                                {
+                                    it = next + static_cast<std::ptrdiff_t>(length);
+                                    out = std::ranges::copy(next, it, out).out;
+                                }
+                                continue;
+                            }
+
+                            static constexpr auto digits = std::string_view("0123456789abcdef");
+                            auto const ch = static_cast<unsigned char>(*next);
+                            out = std::ranges::copy(std::string_view("\\u00"), out).out;
+                            *out++ = digits[ch >> 4];
+                            *out++ = digits[ch & 0xf];
+                        }
+                    }
+
+                    it = std::next(next);
+                }
+                *out++ = '"';
+
+                return out;
+            }
+
+            static auto get_utf8_sequence_length(std::string_view string) -> std::size_t
+            {
+                auto const byte = [&](std::size_t index) { return static_cast<unsigned char>(string[index]); };
+                auto const lead = byte(0);
+
+                auto length = std::size_t(0);
+                auto low = 0x80;
+                auto high = 0xbf;
+
+                if (lead >= 0xc2 && lead <= 0xdf)
+                {
+                    length = 2;
+                }
+                else if (lead >= 0xe0 && lead <= 0xef)
+                {
+                    length = 3;
+                    low = lead == 0xe0 ? 0xa0 : 0x80;
+                    high = lead == 0xed ? 0x9f : 0xbf;
+                }
+                else if (lead >= 0xf0 && lead <= 0xf4)
+                {
+                    length = 4;
+                    low = lead == 0xf0 ? 0x90 : 0x80;
+                    high = lead == 0xf4 ? 0x8f : 0xbf;
+                }
+                else
+                {
+                    return 0;
+                }
+
+                if (string.size() < length || byte(1) < low || byte(1) > high)
+                {
+                    return 0;
+                }
+
+                for (auto i = std::size_t(2); i != length; ++i)
+                {
+                    if (byte(i) < 0x80 || byte(i) > 0xbf)
+                    {
+                        return 0;
+                    }
+                }
+
+                return length;
+            }
+
+            static auto write_json_scalar(JsonType type, std::span<char const> text, std::output_iterator<char> auto out) -> decltype(out)
+            {
+                auto const string = std::string_view(text.data(), text.size());
+
+                switch (type)
+                {
+                    case JsonType::number:
+                        if (string.empty() || !std::isdigit(static_cast<unsigned char>(string.back())))
+                        {
+                            return std::ranges::copy(std::string_view("null"), out).out;
+                        }
+                        return std::ranges::copy(string, out).out;
+                    case JsonType::boolean:
+                        return std::ranges::copy(std::string_view(string == "0" ? "false" : "true"), out).out;
+                    case JsonType::string:
+                        return write_json_string(string, out);
+                }
+
+                std::unreachable();
+            }
+
+            template<typename ...Ts>
+            static auto find_type_handler(std::any const & value) -> TypeHandler const *
+            {
+                auto handler = static_cast<TypeHandler const *>(nullptr);
+                (void) ((TypeHandlerT<Ts>::instance()->holds(value) || TypeHandlerT<Ts>::instance()->holds_vector(value) ? (handler = TypeHandlerT<Ts>::instance(), true) : false) || ...);
+                return handler;
+            }
+
+            static auto write_json_value(Argument const & argument, std::any const & value, std::vector<char> & scratch, std::output_iterator<char> auto out) -> decltype(out)
+            {
+                if (!value.has_value())
+                {
+                    return std::ranges::copy(std::string_view("null"), out).out;
+                }
+
+                auto const * handler = argument.get_type_handler();
+                if (!handler->holds(value) && !handler->holds_vector(value))
+                {
+                    handler = find_type_handler<bool, char, signed char, unsigned char, short, unsigned short, int, unsigned, long, unsigned long, long long, unsigned long long, float, double, long double, std::string>(value);
+                }
+
+                if (handler == nullptr)
+                {
+                    throw type_error(std::format("cannot write argument '{}' of type '{}' as JSON", argument.get_dest_name(), value.type().name()));
+                }
+
+                if (handler->holds(value))
+                {
+                    scratch.clear();
+                    handler->write(value, scratch);
+                    return write_json_scalar(handler->json_type(), scratch, out);
+                }
+
+                *out++ = '[';
+                for (auto i = std::size_t(0); i != handler->size(value); ++i)
+                {
+                    if (i != 0)
+                    {
+                        *out++ = ',';
+                    }
+                    scratch.clear();
+                    handler->write(value, i, scratch);
+                    out = write_json_scalar(handler->json_type(), scratch, out);
+                }
+                *out++ = ']';
+                return out;
+            }
+
+            template<typename T>
+            static constexpr auto binary_kind() -> BinaryKind
+            {
+                if constexpr (std::same_as<T, bool>)
+                {
+                    return BinaryKind::boolean;
+                }
+                else if constexpr (std::same_as<T, std::string>)
+                {
+                    return BinaryKind::string;
+                }
+                else if constexpr (std::floating_point<T>)
+                {
+                    return BinaryKind::floating_point;
+                }
+                else if constexpr (std::signed_integral<T>)
+                {
+                    return BinaryKind::signed_integer;
+                }
+                else if constexpr (std::unsigned_integral<T>)
+                {
+                    return BinaryKind::unsigned_integer;
+                }
+                else
+                {
+                    return BinaryKind::none;
+                }
+            }
+
+            static auto cast_to_const_argument(ArgumentVariant const & av) -> Argument const &
+            {
+                return std::visit([](auto & argument) -> Argument const & { return argument; } , av);
+            }
+
             static auto cast_to_formattable(ArgumentVariant const & av) -> Formattable const &
             {
                 return std::visit([](auto & argument) -> Formattable const & { return argument; } , av);
@@ -2066,5 +4927,22 @@ namespace argparse
             OptString m_epilog;
             OptString m_version;
             Handle m_handle = Handle::errors_help_version;
+            std::pmr::memory_resource * m_memory_resource = nullptr;
+            Cache m_cache;
+            std::size_t m_cached_arguments = 0;
+            bool m_sparse = false;
+            std::optional<std::filesystem::path> m_config_file;
+            std::shared_ptr<ConfigFile const> m_config;
+            std::exception_ptr m_config_error;
+            std::shared_ptr<Parameters const> m_defaults;
+            std::size_t m_defaults_count = 0;
+            std::shared_ptr<FlagIndices const> m_flag_indices;
+            std::size_t m_flag_indices_count = 0;
     };
+
+    template<typename T>
+    constexpr auto ArgType::of() -> ArgType
+    {
+        return ArgType{[]() -> void const * { return ArgumentParser::TypeHandlerT<T>::instance(); }};
+    }
 }
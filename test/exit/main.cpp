@@ -1,5 +1,6 @@
 #include "argparse.hpp"
 #include <iostream>
+#include <string_view>
 
 
 auto main(int argc, char * argv[]) -> int
@@ -8,7 +9,7 @@ auto main(int argc, char * argv[]) -> int
     parser.add_argument("positional");
     parser.add_argument("--optional");
     parser.add_argument("-v", "--version").action(argparse::version).version("1.0.0");
-    auto const args = parser.parse_args(argc, argv);
+    auto const args = argc == 3 && std::string_view(argv[1]) == "--command" ? parser.parse_command(argv[2]) : parser.parse_args(argc, argv);
     std::cout << "positional: " << args.get_value("positional") << '\n';
     std::cout << "optional: " << (args.get("optional") ? args.get_value("optional") : "<none>") << '\n';
 }
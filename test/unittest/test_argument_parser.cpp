@@ -1,6 +1,7 @@
 #include "argparse.hpp"
 
 #include "cstring_array.h"
+#include "custom.h"
 
 #include "doctest.h"
 
@@ -340,7 +341,7 @@ TEST_CASE("Adding an optional argument with required option does not result in e
     auto parser = argparse::ArgumentParser();
 
     CHECK_NOTHROW(parser.add_argument("-o").required(true));
-    CHECK_NOTHROW(parser.add_argument("-o").required(false));
+    CHECK_NOTHROW(parser.add_argument("-p").required(false));
 }
 
 TEST_CASE("ArgumentParser supports mutually exclusive groups")
@@ -433,3 +434,292 @@ TEST_CASE("Requesting wrong argument type throws an exception")
 
     CHECK_THROWS_WITH_AS(args.get_value("pos"), doctest::Contains("wrong type"), argparse::type_error);
 }
+
+TEST_CASE("ArgumentParser can be copied")
+{
+    auto parser = argparse::ArgumentParser().prog("prog");
+    parser.add_argument("pos").type<int>();
+    parser.add_argument("-o").type<double>();
+
+    auto const copy = parser;
+
+    CHECK(copy.format_help() == parser.format_help());
+}
+
+TEST_CASE("Copied ArgumentParser parses independently of the original")
+{
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("pos").type<int>();
+
+    auto copy = parser;
+    copy.add_argument("-o").type<double>();
+
+    auto const args1 = parser.parse_args(2, cstr_arr{"prog", "3"});
+    auto const args2 = copy.parse_args(4, cstr_arr{"prog", "5", "-o", "1.5"});
+
+    CHECK(args1.get_value<int>("pos") == 3);
+    CHECK_THROWS_AS(args1.get("o"), argparse::name_error);
+    CHECK(args2.get_value<int>("pos") == 5);
+    CHECK(args2.get_value<double>("o") == 1.5);
+}
+
+TEST_CASE("ArgumentParser accepts argument names given at compile time")
+{
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument<"pos">();
+    parser.add_argument<"-o", "--option">().type<int>();
+
+    auto const args = parser.parse_args(4, cstr_arr{"prog", "val", "--option", "7"});
+
+    CHECK(args.get_value("pos") == "val");
+    CHECK(args.get_value<int>("option") == 7);
+}
+
+TEST_CASE("Argument names given at compile time produce the same help as names given at run time")
+{
+    auto parser1 = argparse::ArgumentParser().prog("prog");
+    parser1.add_argument<"pos">().help("positional");
+    parser1.add_argument<"-o", "--option">().help("optional");
+
+    auto parser2 = argparse::ArgumentParser().prog("prog");
+    parser2.add_argument("pos").help("positional");
+    parser2.add_argument("-o", "--option").help("optional");
+
+    CHECK(parser1.format_help() == parser2.format_help());
+}
+
+TEST_CASE("Positional argument with name given at compile time does not provide dest and required options")
+{
+    auto const has_dest = []<typename Builder>(Builder & builder) { return requires { builder.dest("d"); }; };
+    auto const has_required = []<typename Builder>(Builder & builder) { return requires { builder.required(true); }; };
+
+    auto parser = argparse::ArgumentParser();
+    auto && positional = parser.add_argument<"pos">();
+    auto && optional = parser.add_argument<"-o">();
+
+    CHECK(!has_dest(positional));
+    CHECK(!has_required(positional));
+    CHECK(has_dest(optional));
+    CHECK(has_required(optional));
+}
+
+TEST_CASE("ArgumentParser supports mutually exclusive groups with names given at compile time")
+{
+    auto parser = argparse::ArgumentParser().handle(argparse::Handle::none);
+    auto group = parser.add_mutually_exclusive_group();
+    group.add_argument<"-a">().action(argparse::store_true);
+    group.add_argument<"-b">().action(argparse::store_true);
+
+    CHECK_THROWS_WITH_AS(parser.parse_args(3, cstr_arr{"prog", "-a", "-b"}), "argument -b: not allowed with argument -a", argparse::parsing_error);
+}
+
+TEST_CASE("ArgumentParser adds arguments of parents")
+{
+    auto parent = argparse::ArgumentParser().add_help(false);
+    parent.add_argument("--parent").type<int>();
+
+    auto parser = argparse::ArgumentParser().parents({parent});
+    parser.add_argument("foo");
+
+    auto args = parser.parse_args(4, cstr_arr{"prog", "--parent", "2", "XXX"});
+
+    CHECK(args.get_value<int>("parent") == 2);
+    CHECK(args.get_value("foo") == "XXX");
+}
+
+TEST_CASE("ArgumentParser does not modify parents")
+{
+    auto parent = argparse::ArgumentParser().prog("prog").add_help(false);
+    parent.add_argument("--parent");
+    auto const help = parent.format_help();
+
+    auto parser = argparse::ArgumentParser().parents({parent});
+    parser.add_argument("--child");
+    (void) parser.parse_args(5, cstr_arr{"prog", "--parent", "p", "--child", "c"});
+
+    CHECK(parent.format_help() == help);
+    CHECK(!parent.parse_args(1, cstr_arr{"prog"}).get("parent"));
+}
+
+TEST_CASE("ArgumentParser adds arguments of multiple parents in order")
+{
+    auto parent1 = argparse::ArgumentParser().add_help(false);
+    parent1.add_argument("-a");
+    auto parent2 = argparse::ArgumentParser().add_help(false);
+    parent2.add_argument("-b");
+
+    auto parser = argparse::ArgumentParser().prog("prog").parents({parent1, parent2});
+
+    CHECK(parser.format_usage() == "usage: prog [-h] [-a A] [-b B]");
+}
+
+TEST_CASE("ArgumentParser throws an exception when parents have conflicting option strings")
+{
+    auto parent = argparse::ArgumentParser();
+
+    CHECK_THROWS_WITH_AS(argparse::ArgumentParser().parents({parent}), "argument -h/--help: conflicting option strings: -h, --help", argparse::option_error);
+}
+
+TEST_CASE("ArgumentParser inherits version of parents")
+{
+    auto parent = argparse::ArgumentParser().prog("prog").add_help(false);
+    parent.add_argument("--version").action(argparse::version).version("1.0");
+
+    auto parser = argparse::ArgumentParser().prog("prog").parents({parent});
+
+    CHECK(parser.format_version() == "1.0");
+}
+
+TEST_CASE("ArgumentParser adds arguments from a table of specs")
+{
+    static constexpr auto specs = std::array<argparse::ArgSpec, 4>{{
+        {.names = {"pos"}, .help = "positional"},
+        {.names = {"-f", "--foo"}, .help = "foo", .metavar = "FOO"},
+        {.names = {"-b"}, .dest = "bar", .action = argparse::store_true},
+        {.names = {"--list"}, .required = true, .nargs = argparse::one_or_more}}};
+
+    auto parser = argparse::ArgumentParser().prog("prog");
+    parser.add_arguments(specs);
+
+    auto args = parser.parse_args(8, cstr_arr{"prog", "p", "-f", "f", "-b", "--list", "1", "2"});
+
+    CHECK(args.get_value("pos") == "p");
+    CHECK(args.get_value("foo") == "f");
+    CHECK(args.get_value<bool>("bar") == true);
+    CHECK(args.get_value<std::vector<std::string>>("list") == std::vector<std::string>{"1", "2"});
+}
+
+TEST_CASE("Arguments added from a table of specs produce the same help as arguments added one by one")
+{
+    static constexpr auto specs = std::array<argparse::ArgSpec, 3>{{
+        {.names = {"pos"}, .help = "positional"},
+        {.names = {"-f", "--foo"}, .help = "foo", .metavar = "FOO"},
+        {.names = {"--opt"}, .nargs = argparse::zero_or_one}}};
+
+    auto parser1 = argparse::ArgumentParser().prog("prog");
+    parser1.add_arguments(specs);
+
+    auto parser2 = argparse::ArgumentParser().prog("prog");
+    parser2.add_argument("pos").help("positional");
+    parser2.add_argument("-f", "--foo").help("foo").metavar("FOO");
+    parser2.add_argument("--opt").nargs(argparse::zero_or_one);
+
+    CHECK(parser1.format_help() == parser2.format_help());
+}
+
+TEST_CASE("ArgumentParser validates the whole table of specs before adding any argument")
+{
+    auto parser = argparse::ArgumentParser().prog("prog");
+    auto const usage = parser.format_usage();
+
+    auto const specs = std::array<argparse::ArgSpec, 2>{{
+        {.names = {"-a"}},
+        {.names = {"pos"}, .dest = "p"}}};
+
+    CHECK_THROWS_WITH_AS(parser.add_arguments(specs), "'dest' is an invalid argument for positionals", argparse::option_error);
+    CHECK(parser.format_usage() == usage);
+}
+
+TEST_CASE("ArgumentParser rejects invalid names in a table of specs")
+{
+    auto parser = argparse::ArgumentParser();
+
+    auto const unnamed = std::array<argparse::ArgSpec, 1>{{{.help = "help"}}};
+    auto const two_positional_names = std::array<argparse::ArgSpec, 1>{{{.names = {"a", "b"}}}};
+    auto const optional_without_dash = std::array<argparse::ArgSpec, 1>{{{.names = {"-a", "b"}}}};
+    auto const required_positional = std::array<argparse::ArgSpec, 1>{{{.names = {"a"}, .required = true}}};
+
+    CHECK_THROWS_WITH_AS(parser.add_arguments(unnamed), "argument needs a name", argparse::option_error);
+    CHECK_THROWS_WITH_AS(parser.add_arguments(two_positional_names), "argument a: positional argument must have exactly one name", argparse::option_error);
+    CHECK_THROWS_WITH_AS(parser.add_arguments(optional_without_dash), "argument b: optional argument names must start with '-'", argparse::option_error);
+    CHECK_THROWS_WITH_AS(parser.add_arguments(required_positional), "'required' is an invalid argument for positionals", argparse::option_error);
+}
+
+TEST_CASE("ArgumentParser rejects dashes-only names in a table of specs")
+{
+    auto parser = argparse::ArgumentParser();
+
+    auto const single_dash = std::array<argparse::ArgSpec, 1>{{{.names = {"-a", "-"}}}};
+    auto const double_dash = std::array<argparse::ArgSpec, 1>{{{.names = {"--"}}}};
+
+    CHECK_THROWS_WITH_AS(parser.add_arguments(single_dash), "argument -a: optional argument names must not consist of dashes only", argparse::option_error);
+    CHECK_THROWS_WITH_AS(parser.add_arguments(double_dash), "argument --: optional argument names must not consist of dashes only", argparse::option_error);
+}
+
+TEST_CASE("ArgumentParser rejects conflicting names in a table of specs")
+{
+    auto parser = argparse::ArgumentParser().prog("prog");
+    parser.add_argument("-a");
+    auto const usage = parser.format_usage();
+
+    auto const with_existing = std::array<argparse::ArgSpec, 1>{{{.names = {"-b", "-a"}}}};
+    auto const within_table = std::array<argparse::ArgSpec, 2>{{{.names = {"-c", "--cc"}}, {.names = {"--cc"}}}};
+
+    CHECK_THROWS_WITH_AS(parser.add_arguments(with_existing), "argument -b/-a: conflicting option string: -a", argparse::option_error);
+    CHECK_THROWS_WITH_AS(parser.add_arguments(within_table), "argument --cc: conflicting option string: --cc", argparse::option_error);
+    CHECK(parser.format_usage() == usage);
+}
+
+TEST_CASE("ArgumentParser rejects conflicting names added one by one")
+{
+    auto parser = argparse::ArgumentParser().prog("prog");
+    parser.add_argument("-a", "--all");
+
+    CHECK_THROWS_WITH_AS(parser.add_argument("--all"), "argument --all: conflicting option string: --all", argparse::option_error);
+    CHECK_THROWS_WITH_AS(parser.add_argument("-h"), "argument -h: conflicting option string: -h", argparse::option_error);
+}
+
+TEST_CASE("ArgumentParser takes version from a table of specs")
+{
+    static constexpr auto specs = std::array<argparse::ArgSpec, 1>{{{.names = {"--version"}, .action = argparse::version, .version = "1.2"}}};
+
+    auto parser = argparse::ArgumentParser().prog("prog");
+    parser.add_arguments(specs);
+
+    CHECK(parser.format_version() == "1.2");
+}
+
+TEST_CASE("ArgumentParser rejects version action without version in a table of specs")
+{
+    auto parser = argparse::ArgumentParser().prog("prog");
+
+    auto const specs = std::array<argparse::ArgSpec, 1>{{{.names = {"--version"}, .action = argparse::version}}};
+
+    CHECK_THROWS_WITH_AS(parser.add_arguments(specs), "argument --version: 'version' action requires a version", argparse::option_error);
+}
+
+TEST_CASE("ArgumentParser adds typed arguments with const, default and choices from a table of specs")
+{
+    static constexpr auto choices = std::array<std::string_view, 3>{"1", "2", "3"};
+    static constexpr auto specs = std::array<argparse::ArgSpec, 3>{{
+        {.names = {"-n"}, .type = argparse::ArgType::of<int>(), .default_ = "2", .choices = choices},
+        {.names = {"-c"}, .action = argparse::store_const, .type = argparse::ArgType::of<int>(), .const_ = "5", .default_ = "1"},
+        {.names = {"--custom"}, .type = argparse::ArgType::of<foo::Custom>()}}};
+
+    auto parser = argparse::ArgumentParser().prog("prog").handle(argparse::Handle::none);
+    parser.add_arguments(specs);
+
+    auto const defaults = parser.parse_args(1, cstr_arr{"prog"});
+    auto const args = parser.parse_args(5, cstr_arr{"prog", "-n", "3", "-c", "--custom=x"});
+
+    CHECK(defaults.get_value<int>("n") == 2);
+    CHECK(defaults.get_value<int>("c") == 1);
+    CHECK(args.get_value<int>("n") == 3);
+    CHECK(args.get_value<int>("c") == 5);
+    CHECK(args.get_value<foo::Custom>("custom").m_text == "x");
+    CHECK_THROWS_WITH_AS(parser.parse_args(3, cstr_arr{"prog", "-n", "4"}), "argument -n: invalid choice: 4 (choose from 1, 2, 3)", argparse::parsing_error);
+}
+
+TEST_CASE("ArgumentParser rejects values that do not convert to the type in a table of specs")
+{
+    auto parser = argparse::ArgumentParser().prog("prog");
+
+    static constexpr auto choices = std::array<std::string_view, 1>{"x"};
+    auto const bad_default = std::array<argparse::ArgSpec, 1>{{{.names = {"-a"}, .type = argparse::ArgType::of<int>(), .default_ = "x"}}};
+    auto const bad_const = std::array<argparse::ArgSpec, 1>{{{.names = {"-a"}, .action = argparse::store_const, .type = argparse::ArgType::of<int>(), .const_ = "x"}}};
+    auto const bad_choice = std::array<argparse::ArgSpec, 1>{{{.names = {"-a"}, .type = argparse::ArgType::of<int>(), .choices = choices}}};
+
+    CHECK_THROWS_WITH_AS(parser.add_arguments(bad_default), "argument -a: invalid default value: 'x'", argparse::option_error);
+    CHECK_THROWS_WITH_AS(parser.add_arguments(bad_const), "argument -a: invalid const value: 'x'", argparse::option_error);
+    CHECK_THROWS_WITH_AS(parser.add_arguments(bad_choice), "argument -a: invalid choice value: 'x'", argparse::option_error);
+}
@@ -0,0 +1,105 @@
+#include "argparse.hpp"
+
+#include "cstring_array.h"
+
+#include "doctest.h"
+
+#include <charconv>
+#include <cstdint>
+#include <expected>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+
+using namespace std::string_literals;
+
+namespace foo
+{
+    struct Port
+    {
+        std::uint16_t number = 0;
+    };
+}
+
+template<>
+class argparse::Converter<foo::Port>
+{
+    public:
+        auto from_string(std::string_view s) const -> std::expected<foo::Port, argparse::ConversionError>
+        {
+            auto port = foo::Port();
+            auto const [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), port.number);
+
+            if (ec == std::errc::result_out_of_range)
+            {
+                return std::unexpected(argparse::ConversionError{"port number out of range"});
+            }
+            if (ec != std::errc() || ptr != s.data() + s.size())
+            {
+                return std::unexpected(argparse::ConversionError{"not a port number"});
+            }
+            return port;
+        }
+
+        auto to_string(foo::Port const & t) const -> std::string
+        {
+            return std::to_string(t.number);
+        }
+
+        auto are_equal(foo::Port const & lhs, foo::Port const & rhs) const -> bool
+        {
+            return lhs.number == rhs.number;
+        }
+};
+
+TEST_CASE("Converter taking string_view is detected")
+{
+    CHECK(argparse::expected_converter<foo::Port>);
+    CHECK(!argparse::expected_converter<int>);
+    CHECK(!argparse::expected_converter<std::string>);
+}
+
+TEST_CASE("Converter taking string_view is used by from_string")
+{
+    CHECK(argparse::from_string<foo::Port>("8080")->number == 8080);
+    CHECK(!argparse::from_string<foo::Port>("http").has_value());
+}
+
+TEST_CASE("Parsing an optional argument uses converter taking string_view")
+{
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("--port").type<foo::Port>();
+
+    auto const args = parser.parse_args(3, cstr_arr{"prog", "--port", "8080"});
+
+    CHECK(args.get_value<foo::Port>("port").number == 8080);
+}
+
+TEST_CASE("Parsing a positional argument uses converter taking string_view")
+{
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("port").type<foo::Port>();
+
+    auto const args = parser.parse_args(2, cstr_arr{"prog", "443"});
+
+    CHECK(args.get_value<foo::Port>("port").number == 443);
+}
+
+TEST_CASE("Parsing an argument reports the reason given by converter taking string_view")
+{
+    auto parser = argparse::ArgumentParser().handle(argparse::Handle::none);
+    parser.add_argument("--port").type<foo::Port>();
+
+    CHECK_THROWS_WITH_AS(parser.parse_args(3, cstr_arr{"prog", "--port", "http"}), "argument --port: invalid value: 'http' (not a port number)", argparse::parsing_error);
+    CHECK_THROWS_WITH_AS(parser.parse_args(3, cstr_arr{"prog", "--port", "65536"}), "argument --port: invalid value: '65536' (port number out of range)", argparse::parsing_error);
+}
+
+TEST_CASE("Parsing an argument with choices uses converter taking string_view")
+{
+    auto parser = argparse::ArgumentParser().handle(argparse::Handle::none);
+    parser.add_argument("--port").choices({foo::Port{80}, foo::Port{443}}).type<foo::Port>();
+
+    CHECK(parser.parse_args(3, cstr_arr{"prog", "--port", "443"}).get_value<foo::Port>("port").number == 443);
+    CHECK_THROWS_WITH_AS(parser.parse_args(3, cstr_arr{"prog", "--port", "8080"}), "argument --port: invalid choice: 8080 (choose from 80, 443)", argparse::parsing_error);
+}
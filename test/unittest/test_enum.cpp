@@ -0,0 +1,104 @@
+#include "argparse.hpp"
+
+#include "cstring_array.h"
+
+#include "doctest.h"
+
+#include <array>
+#include <string>
+
+
+using namespace std::string_literals;
+
+namespace
+{
+    enum class Colour
+    {
+        red,
+        green,
+        blue
+    };
+
+    constexpr auto colour_names = std::to_array<argparse::EnumName<Colour>>({
+        {"red", Colour::red},
+        {"green", Colour::green},
+        {"blue", Colour::blue}});
+}
+
+template<>
+class argparse::Converter<Colour> : public argparse::EnumConverter<colour_names>
+{
+};
+
+TEST_CASE("Enum converter converts names to values")
+{
+    CHECK(argparse::from_string<Colour>("red") == Colour::red);
+    CHECK(argparse::from_string<Colour>("green") == Colour::green);
+    CHECK(argparse::from_string<Colour>("blue") == Colour::blue);
+}
+
+TEST_CASE("Enum converter rejects unknown names")
+{
+    CHECK(!argparse::from_string<Colour>("yellow").has_value());
+    CHECK(!argparse::from_string<Colour>("").has_value());
+    CHECK(!argparse::from_string<Colour>("Red").has_value());
+}
+
+TEST_CASE("Enum converter converts values to names")
+{
+    CHECK(argparse::to_string(Colour::red) == "red"s);
+    CHECK(argparse::to_string(Colour::green) == "green"s);
+    CHECK(argparse::to_string(Colour::blue) == "blue"s);
+}
+
+TEST_CASE("Parsing an optional argument of enum type yields correct value")
+{
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("-c").type<Colour>();
+
+    auto const args = parser.parse_args(3, cstr_arr{"prog", "-c", "green"});
+
+    CHECK(args.get_value<Colour>("c") == Colour::green);
+}
+
+TEST_CASE("Parsing an optional argument of enum type throws an exception on unknown name")
+{
+    auto parser = argparse::ArgumentParser().handle(argparse::Handle::none);
+    parser.add_argument("-c").type<Colour>();
+
+    CHECK_THROWS_WITH_AS(parser.parse_args(3, cstr_arr{"prog", "-c", "yellow"}), "argument -c: invalid value: 'yellow' (choose from red, green, blue)", argparse::parsing_error);
+}
+
+TEST_CASE("Parsing an optional argument of enum type respects explicitly set choices")
+{
+    auto parser = argparse::ArgumentParser().handle(argparse::Handle::none);
+    parser.add_argument("-c").choices({Colour::red, Colour::blue}).type<Colour>();
+
+    CHECK_THROWS_WITH_AS(parser.parse_args(3, cstr_arr{"prog", "-c", "green"}), "argument -c: invalid choice: green (choose from red, blue)", argparse::parsing_error);
+}
+
+TEST_CASE("ArgumentParser lists enum names as choices in usage message")
+{
+    auto parser = argparse::ArgumentParser().prog("prog");
+    parser.add_argument("-c").type<Colour>();
+
+    CHECK(parser.format_usage() == "usage: prog [-h] [-c {red,green,blue}]"s);
+}
+
+TEST_CASE("ArgumentParser lists enum names as choices in help message")
+{
+    auto parser = argparse::ArgumentParser().prog("prog");
+    parser.add_argument("colour").type<Colour>();
+
+    CHECK(parser.format_help() == "usage: prog [-h] {red,green,blue}\n\npositional arguments:\n  {red,green,blue}\n\noptional arguments:\n  -h, --help            show this help message and exit"s);
+}
+
+TEST_CASE("Enum type given in a table of specs provides default choices")
+{
+    static constexpr auto specs = std::array<argparse::ArgSpec, 1>{{{.names = {"--colour"}, .type = argparse::ArgType::of<Colour>()}}};
+
+    auto parser = argparse::ArgumentParser().prog("prog");
+    parser.add_arguments(specs);
+
+    CHECK(parser.format_usage() == "usage: prog [-h] [--colour {red,green,blue}]");
+}
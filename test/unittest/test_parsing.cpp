@@ -4,7 +4,16 @@
 
 #include "doctest.h"
 
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <sstream>
 #include <string>
+#include <string_view>
+#include <vector>
 
 
 using namespace std::string_literals;
@@ -247,3 +256,535 @@ TEST_CASE("Optional argument does not consume unexpected joined value")
 
     CHECK_THROWS_WITH_AS(parser.parse_args(2, cstr_arr{"prog", "--option=val"}), "argument --option: ignored explicit argument 'val'", argparse::parsing_error);
 }
+
+namespace
+{
+    class CountingResource : public std::pmr::memory_resource
+    {
+        public:
+            std::size_t m_allocations = 0;
+
+        private:
+            auto do_allocate(std::size_t bytes, std::size_t alignment) -> void * override
+            {
+                ++m_allocations;
+                return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+            }
+
+            auto do_deallocate(void * p, std::size_t bytes, std::size_t alignment) -> void override
+            {
+                std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+            }
+
+            auto do_is_equal(std::pmr::memory_resource const & other) const noexcept -> bool override
+            {
+                return this == &other;
+            }
+    };
+}
+
+TEST_CASE("Parsing arguments allocates from memory resource passed to parse_args")
+{
+    auto resource = CountingResource();
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("pos");
+    parser.add_argument("-o").type<int>();
+
+    auto const args = parser.parse_args(4, cstr_arr{"prog", "val", "-o", "5"}, &resource);
+
+    CHECK(resource.m_allocations > 0);
+    CHECK(args.get_value("pos") == "val");
+    CHECK(args.get_value<int>("o") == 5);
+}
+
+TEST_CASE("Parsing arguments allocates from memory resource set on parser")
+{
+    auto resource = CountingResource();
+    auto parser = argparse::ArgumentParser().memory_resource(&resource);
+    parser.add_argument("pos");
+
+    auto const args = parser.parse_args(2, cstr_arr{"prog", "val"});
+
+    CHECK(resource.m_allocations > 0);
+    CHECK(args.get_value("pos") == "val");
+}
+
+TEST_CASE("Parsing arguments allocates nothing from default resource when memory resource is passed to parse_args")
+{
+    auto default_resource = CountingResource();
+    auto resource = CountingResource();
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("--append").action(argparse::append);
+    parser.add_argument("--store");
+
+    auto * const previous = std::pmr::set_default_resource(&default_resource);
+    auto const args = parser.parse_args(4, cstr_arr{"prog", "--append=a-rather-long-appended-value", "--store=a-rather-long-stored-value", "--append=another-rather-long-appended-value"}, &resource);
+    std::pmr::set_default_resource(previous);
+
+    CHECK(default_resource.m_allocations == 0);
+    CHECK(resource.m_allocations > 0);
+    CHECK(args.get_value<std::vector<std::string>>("append") == std::vector<std::string>{"a-rather-long-appended-value", "another-rather-long-appended-value"});
+}
+
+TEST_CASE("Parsing arguments uses the default resource current at parse time")
+{
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("pos");
+
+    auto resource = CountingResource();
+    auto * const previous = std::pmr::set_default_resource(&resource);
+    auto const args = parser.parse_args(2, cstr_arr{"prog", "a-rather-long-positional-value"});
+    std::pmr::set_default_resource(previous);
+
+    CHECK(resource.m_allocations > 0);
+    CHECK(args.get_value("pos") == "a-rather-long-positional-value");
+}
+
+TEST_CASE("Parsing arguments with monotonic buffer resource gives correct results")
+{
+    auto buffer = std::array<std::byte, 4096>();
+    auto resource = std::pmr::monotonic_buffer_resource(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("pos");
+    parser.add_argument("--long-option");
+
+    auto const args = parser.parse_args(4, cstr_arr{"prog", "a-rather-long-positional-value", "--long-option", "another-rather-long-value"}, &resource);
+
+    CHECK(args.get_value("pos") == "a-rather-long-positional-value");
+    CHECK(args.get_value("long_option") == "another-rather-long-value");
+}
+
+TEST_CASE("Parsing arguments with cache returns the same result for the same arguments")
+{
+    auto parser = argparse::ArgumentParser().cache(4);
+    parser.add_argument("pos");
+
+    auto const args1 = parser.parse_args_cached(2, cstr_arr{"prog", "val"});
+    auto const args2 = parser.parse_args_cached(2, cstr_arr{"prog", "val"});
+
+    CHECK(args1 == args2);
+    CHECK(args2->get_value("pos") == "val");
+    CHECK(parser.cache_stats().hits == 1);
+    CHECK(parser.cache_stats().misses == 1);
+}
+
+TEST_CASE("Parsing arguments with cache distinguishes different arguments")
+{
+    auto parser = argparse::ArgumentParser().cache(4);
+    parser.add_argument("pos");
+    parser.add_argument("-o");
+
+    auto const args1 = parser.parse_args_cached(4, cstr_arr{"prog", "val", "-o", "a"});
+    auto const args2 = parser.parse_args_cached(4, cstr_arr{"prog", "val", "-o", "b"});
+    auto const args3 = parser.parse_args_cached(3, cstr_arr{"prog", "val", "-oa"});
+
+    CHECK(args1 != args2);
+    CHECK(args1->get_value("o") == "a");
+    CHECK(args2->get_value("o") == "b");
+    CHECK(args3 != args1);
+    CHECK(args3->get_value("o") == "a");
+    CHECK(parser.cache_stats().hits == 0);
+    CHECK(parser.cache_stats().misses == 3);
+}
+
+TEST_CASE("Parsing arguments with cache evicts least recently used result")
+{
+    auto parser = argparse::ArgumentParser().cache(2);
+    parser.add_argument("pos");
+
+    auto const a = parser.parse_args_cached(2, cstr_arr{"prog", "a"});
+    auto const b = parser.parse_args_cached(2, cstr_arr{"prog", "b"});
+    (void) parser.parse_args_cached(2, cstr_arr{"prog", "a"});
+    auto const c = parser.parse_args_cached(2, cstr_arr{"prog", "c"});
+
+    CHECK(parser.parse_args_cached(2, cstr_arr{"prog", "a"}) == a);
+    CHECK(parser.parse_args_cached(2, cstr_arr{"prog", "c"}) == c);
+    CHECK(parser.parse_args_cached(2, cstr_arr{"prog", "b"}) != b);
+    CHECK(parser.cache_stats().hits == 3);
+    CHECK(parser.cache_stats().misses == 4);
+}
+
+TEST_CASE("Parsing arguments without cache enabled always parses")
+{
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("pos");
+
+    auto const args1 = parser.parse_args_cached(2, cstr_arr{"prog", "val"});
+    auto const args2 = parser.parse_args_cached(2, cstr_arr{"prog", "val"});
+
+    CHECK(args1 != args2);
+    CHECK(parser.cache_stats().hits == 0);
+    CHECK(parser.cache_stats().misses == 0);
+}
+
+TEST_CASE("Parsing arguments with cache allocates cached results independently of the parser's memory resource")
+{
+    auto resource = CountingResource();
+    auto parser = argparse::ArgumentParser().memory_resource(&resource).cache(4);
+    parser.add_argument("pos");
+
+    auto const args = parser.parse_args_cached(2, cstr_arr{"prog", "a-rather-long-positional-value"});
+
+    CHECK(resource.m_allocations == 0);
+    CHECK(args->get_value("pos") == "a-rather-long-positional-value");
+}
+
+TEST_CASE("Parsing arguments with cache sees arguments added after previous parse")
+{
+    auto parser = argparse::ArgumentParser().cache(4);
+    parser.add_argument("pos");
+
+    (void) parser.parse_args_cached(2, cstr_arr{"prog", "val"});
+    parser.add_argument("-o").default_("x"s);
+    auto const args = parser.parse_args_cached(2, cstr_arr{"prog", "val"});
+
+    CHECK(args->get_value("o") == "x");
+    CHECK(parser.cache_stats().hits == 0);
+}
+
+TEST_CASE("Parsing arguments with cache sees arguments added to a mutually exclusive group after previous parse")
+{
+    auto parser = argparse::ArgumentParser().cache(4);
+    parser.add_argument("pos");
+
+    (void) parser.parse_args_cached(2, cstr_arr{"prog", "val"});
+    auto group = parser.add_mutually_exclusive_group();
+    group.add_argument("-o").default_("x"s);
+    auto const args = parser.parse_args_cached(2, cstr_arr{"prog", "val"});
+
+    CHECK(args->get_value("o") == "x");
+    CHECK(parser.cache_stats().hits == 0);
+}
+
+TEST_CASE("Parsing arguments with cache sees help removed after previous parse")
+{
+    auto parser = argparse::ArgumentParser().cache(4);
+    parser.add_argument("pos");
+
+    (void) parser.parse_args_cached(2, cstr_arr{"prog", "val"});
+    parser.add_help(false);
+    auto const args = parser.parse_args_cached(2, cstr_arr{"prog", "val"});
+
+    CHECK_THROWS_AS((void) args->get("help"), argparse::name_error);
+    CHECK(parser.cache_stats().hits == 0);
+}
+
+TEST_CASE("Copying a parser with cache does not copy cached results")
+{
+    auto parser = argparse::ArgumentParser().cache(4);
+    parser.add_argument("pos");
+
+    auto const args1 = parser.parse_args_cached(2, cstr_arr{"prog", "val"});
+    auto copy = parser;
+    auto const args2 = copy.parse_args_cached(2, cstr_arr{"prog", "val"});
+    auto const args3 = copy.parse_args_cached(2, cstr_arr{"prog", "val"});
+
+    CHECK(args1 != args2);
+    CHECK(args2 == args3);
+    CHECK(copy.cache_stats().hits == 1);
+    CHECK(copy.cache_stats().misses == 1);
+}
+
+TEST_CASE("Parsing arguments twice with the same parser does not accumulate counts")
+{
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("-c").action(argparse::count);
+
+    (void) parser.parse_args(3, cstr_arr{"prog", "-c", "-c"});
+    auto const args = parser.parse_args(2, cstr_arr{"prog", "-c"});
+
+    CHECK(args.get_value<int>("c") == 1);
+}
+
+TEST_CASE("Parsing arguments twice with the same parser does not accumulate appended values")
+{
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("-a").action(argparse::append);
+
+    (void) parser.parse_args(3, cstr_arr{"prog", "-a", "x"});
+    auto const args = parser.parse_args(3, cstr_arr{"prog", "-a", "y"});
+
+    CHECK(args.get_value<std::vector<std::string>>("a") == std::vector<std::string>{"y"});
+}
+
+TEST_CASE("Parsing arguments twice with the same parser does not keep mutually exclusive arguments present")
+{
+    auto parser = argparse::ArgumentParser().handle(argparse::Handle::none);
+    auto group = parser.add_mutually_exclusive_group();
+    group.add_argument("-a").action(argparse::store_true);
+    group.add_argument("-b").action(argparse::store_true);
+
+    (void) parser.parse_args(2, cstr_arr{"prog", "-a"});
+
+    CHECK_NOTHROW(parser.parse_args(2, cstr_arr{"prog", "-b"}));
+}
+
+namespace
+{
+    struct Tracked
+    {
+        Tracked()
+        {
+            ++live;
+        }
+
+        Tracked(Tracked const &)
+        {
+            ++live;
+        }
+
+        ~Tracked()
+        {
+            --live;
+        }
+
+        Tracked & operator=(Tracked const &) = default;
+
+        static inline auto live = 0;
+    };
+}
+
+namespace argparse
+{
+template<>
+class Converter<Tracked>
+{
+    public:
+        auto from_string(std::string const & /* s */) const -> std::optional<Tracked>
+        {
+            return Tracked();
+        }
+
+        auto to_string(Tracked const & /* t */) const -> std::string
+        {
+            return "tracked";
+        }
+
+        auto are_equal(Tracked const & /* lhs */, Tracked const & /* rhs */) const -> bool
+        {
+            return true;
+        }
+};
+}
+
+TEST_CASE("Resetting parser releases parsed values")
+{
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("-t").type<Tracked>();
+
+    (void) parser.parse_args(3, cstr_arr{"prog", "-t", "x"});
+    REQUIRE(Tracked::live == 1);
+
+    parser.reset();
+
+    CHECK(Tracked::live == 0);
+}
+
+TEST_CASE("Parsing arguments after resetting parser does not see previous values")
+{
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("-c").action(argparse::count);
+
+    (void) parser.parse_args(3, cstr_arr{"prog", "-c", "-c"});
+    parser.reset();
+    auto const args = parser.parse_args(2, cstr_arr{"prog", "-c"});
+
+    CHECK(args.get_value<int>("c") == 1);
+}
+
+TEST_CASE("Parsing arguments in sparse mode returns the same values as in full mode")
+{
+    auto const make_parser = [](bool sparse)
+    {
+        auto parser = argparse::ArgumentParser().sparse(sparse);
+        parser.add_argument("pos");
+        parser.add_argument("-a").default_(std::string("default"));
+        parser.add_argument("-b").action(argparse::store_true);
+        parser.add_argument("-c").action(argparse::count);
+        parser.add_argument("--d-e").type<int>();
+        return parser;
+    };
+
+    auto full = make_parser(false);
+    auto sparse = make_parser(true);
+
+    auto const full_args = full.parse_args(4, cstr_arr{"prog", "p", "--d-e", "5"});
+    auto const sparse_args = sparse.parse_args(4, cstr_arr{"prog", "p", "--d-e", "5"});
+
+    CHECK(sparse_args.get_value("pos") == full_args.get_value("pos"));
+    CHECK(sparse_args.get_value("a") == full_args.get_value("a"));
+    CHECK(sparse_args.get_value<bool>("b") == full_args.get_value<bool>("b"));
+    CHECK(!sparse_args.get("c"));
+    CHECK(sparse_args.get_value<int>("d_e") == full_args.get_value<int>("d_e"));
+    CHECK_THROWS_WITH_AS(sparse_args.get("e"), "no such argument: 'e'", argparse::name_error);
+}
+
+TEST_CASE("Parsing arguments in sparse mode stores only present arguments in the result's resource")
+{
+    auto resource = CountingResource();
+
+    auto parser = argparse::ArgumentParser().sparse(true);
+    for (auto i = 0; i != 100; ++i)
+    {
+        parser.add_argument("--option" + std::to_string(i));
+    }
+
+    (void) parser.parse_args(1, cstr_arr{"prog"});
+
+    auto const args = parser.parse_args(3, cstr_arr{"prog", "--option7", "x"}, &resource);
+
+    CHECK(resource.m_allocations < 10);
+    CHECK(args.get_value("option7") == "x");
+    CHECK(!args.get("option8"));
+}
+
+TEST_CASE("Parsing arguments in sparse mode sees arguments added after previous parse")
+{
+    auto parser = argparse::ArgumentParser().sparse(true);
+    parser.add_argument("-a").default_(std::string("a"));
+
+    (void) parser.parse_args(1, cstr_arr{"prog"});
+
+    parser.add_argument("-b").default_(std::string("b"));
+
+    auto const args = parser.parse_args(1, cstr_arr{"prog"});
+
+    CHECK(args.get_value("a") == "a");
+    CHECK(args.get_value("b") == "b");
+}
+
+TEST_CASE("Parsing arguments stores boolean flags in a bitset")
+{
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("-a").action(argparse::store_true);
+    parser.add_argument("-o");
+    parser.add_argument("-b").action(argparse::store_false);
+    parser.add_argument("--long-flag").action(argparse::store_true);
+
+    auto const a = parser.flag_index("a");
+    auto const b = parser.flag_index("b");
+    auto const long_flag = parser.flag_index("long_flag");
+
+    auto const args = parser.parse_args(3, cstr_arr{"prog", "-b", "--long-flag"});
+
+    CHECK(args.get_flag(parser.flag_index("help")) == false);
+    CHECK(args.get_flag(a) == false);
+    CHECK(args.get_flag(b) == false);
+    CHECK(args.get_flag(long_flag) == true);
+    CHECK(args.get_value<bool>("long_flag") == true);
+}
+
+TEST_CASE("Parsing arguments stores more than 64 boolean flags")
+{
+    auto parser = argparse::ArgumentParser().add_help(false);
+    for (auto i = 0; i != 100; ++i)
+    {
+        parser.add_argument("--flag" + std::to_string(i)).action(argparse::store_true);
+    }
+
+    auto const args = parser.parse_args(3, cstr_arr{"prog", "--flag3", "--flag70"});
+
+    for (auto i = 0; i != 100; ++i)
+    {
+        CHECK(args.get_flag(parser.flag_index("flag" + std::to_string(i))) == (i == 3 || i == 70));
+    }
+    CHECK_THROWS_WITH_AS(args.get_flag(100), "no such flag: 100", argparse::name_error);
+}
+
+TEST_CASE("Parsing arguments in sparse mode stores boolean flags in a bitset")
+{
+    auto parser = argparse::ArgumentParser().sparse(true);
+    parser.add_argument("-a").action(argparse::store_true);
+    parser.add_argument("-b").action(argparse::store_false);
+
+    auto const args = parser.parse_args(2, cstr_arr{"prog", "-a"});
+
+    CHECK(args.get_flag(parser.flag_index("a")) == true);
+    CHECK(args.get_flag(parser.flag_index("b")) == true);
+    CHECK(args.get_value<bool>("a") == true);
+    CHECK(args.get_value<bool>("b") == true);
+    CHECK(args.get_value<bool>("help") == false);
+}
+
+TEST_CASE("Flag indices follow the arguments after help is removed")
+{
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("-a").action(argparse::store_true);
+
+    CHECK(parser.flag_index("a") == 1);
+
+    (void) std::move(parser).add_help(false);
+
+    CHECK(parser.flag_index("a") == 0);
+    CHECK(parser.parse_args(2, cstr_arr{"prog", "-a"}).get_flag(0) == true);
+}
+
+TEST_CASE("Getting flag index of argument which is not a flag throws an exception")
+{
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("-o");
+
+    CHECK_THROWS_WITH_AS(parser.flag_index("o"), "argument 'o' is not a flag", argparse::type_error);
+    CHECK_THROWS_WITH_AS(parser.flag_index("x"), "no such argument: 'x'", argparse::name_error);
+}
+
+TEST_CASE("Parsing a range of strings parses all of them as arguments")
+{
+    auto parser = argparse::ArgumentParser().prog("prog");
+    parser.add_argument("pos");
+    parser.add_argument("-o").type<int>();
+
+    auto const args = parser.parse_args(std::vector<std::string>{"p", "-o", "1"});
+
+    CHECK(args.get_value("pos") == "p");
+    CHECK(args.get_value<int>("o") == 1);
+}
+
+TEST_CASE("Parsing a span of string views parses all of them as arguments")
+{
+    auto parser = argparse::ArgumentParser().prog("prog");
+    parser.add_argument("pos");
+    parser.add_argument("-o").type<int>();
+
+    auto const strings = std::array<std::string_view, 3>{"-o", "2", "p"};
+    auto const args = parser.parse_args(std::span(strings));
+
+    CHECK(args.get_value("pos") == "p");
+    CHECK(args.get_value<int>("o") == 2);
+}
+
+TEST_CASE("Parsing an input range of strings parses all of them as arguments")
+{
+    auto parser = argparse::ArgumentParser().prog("prog");
+    parser.add_argument("pos");
+    parser.add_argument("-o").type<int>();
+
+    auto stream = std::istringstream("p -o 3");
+    auto const args = parser.parse_args(std::views::istream<std::string>(stream));
+
+    CHECK(args.get_value("pos") == "p");
+    CHECK(args.get_value<int>("o") == 3);
+}
+
+TEST_CASE("Parsing a range of strings with memory resource allocates the result from it")
+{
+    auto buffer = std::array<std::byte, 4096>();
+    auto resource = std::pmr::monotonic_buffer_resource(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+
+    auto parser = argparse::ArgumentParser().prog("prog");
+    parser.add_argument("pos");
+
+    auto const args = parser.parse_args(std::vector<std::string_view>{"p"}, &resource);
+
+    CHECK(args.get_value("pos") == "p");
+}
+
+TEST_CASE("Parsing a range of strings leaves the program name unset")
+{
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("pos");
+
+    (void) parser.parse_args(std::vector<std::string>{"p"});
+
+    CHECK(parser.format_usage() == "usage: [-h] pos"s);
+}
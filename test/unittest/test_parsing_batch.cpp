@@ -0,0 +1,117 @@
+#include "argparse.hpp"
+
+#include "doctest.h"
+
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+using namespace std::string_literals;
+
+TEST_CASE("Parsing a batch of inputs yields results in input order")
+{
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("pos").type<int>();
+    parser.add_argument("-o");
+
+    auto inputs = std::vector<std::vector<std::string>>();
+    for (auto i = 0; i < 1000; ++i)
+    {
+        inputs.push_back({std::to_string(i), "-o", "opt" + std::to_string(i)});
+    }
+
+    auto const results = parser.parse_batch(inputs, 4);
+
+    REQUIRE(results.size() == inputs.size());
+    for (auto i = 0; i < 1000; ++i)
+    {
+        auto const & result = results[static_cast<std::size_t>(i)];
+        REQUIRE(result.has_value());
+        CHECK(result->get_value<int>("pos") == i);
+        CHECK(result->get_value("o") == "opt" + std::to_string(i));
+    }
+}
+
+TEST_CASE("Parsing a batch of inputs reports errors for each input")
+{
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("pos").type<int>();
+
+    auto const inputs = std::vector<std::vector<std::string_view>>{{"1"}, {"a"}, {}, {"2", "3"}};
+
+    auto const results = parser.parse_batch(inputs, 2);
+
+    REQUIRE(results.size() == 4);
+    CHECK(results[0].has_value());
+    CHECK(results[1].error() == "argument pos: invalid value: 'a'");
+    CHECK(results[2].error() == "the following arguments are required: pos");
+    CHECK(results[3].error() == "unrecognised arguments: 3");
+}
+
+TEST_CASE("Parsing a batch of inputs does not modify the parser")
+{
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("-c").action(argparse::count);
+
+    auto const inputs = std::vector<std::vector<std::string>>(10, {"-c", "-c"});
+
+    auto const results = parser.parse_batch(inputs, 3);
+
+    for (auto const & result : results)
+    {
+        CHECK(result->get_value<int>("c") == 2);
+    }
+}
+
+TEST_CASE("Parsing an empty batch of inputs yields no results")
+{
+    auto parser = argparse::ArgumentParser();
+
+    CHECK(parser.parse_batch(std::vector<std::vector<std::string>>()).empty());
+}
+
+TEST_CASE("Parsing a batch of inputs allocates from a synchronized memory resource passed to parse_batch")
+{
+    auto resource = std::pmr::synchronized_pool_resource();
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("pos");
+
+    auto inputs = std::vector<std::vector<std::string>>();
+    for (auto i = 0; i < 1000; ++i)
+    {
+        inputs.push_back({"a-rather-long-positional-value-" + std::to_string(i)});
+    }
+
+    auto const results = parser.parse_batch(inputs, 8, &resource);
+
+    REQUIRE(results.size() == 1000);
+    for (auto i = 0; i < 1000; ++i)
+    {
+        REQUIRE(results[static_cast<std::size_t>(i)].has_value());
+        CHECK(results[static_cast<std::size_t>(i)]->get_value("pos") == "a-rather-long-positional-value-" + std::to_string(i));
+    }
+}
+
+TEST_CASE("Parsing a batch of inputs does not allocate from the memory resource set on the parser")
+{
+    auto resource = std::pmr::monotonic_buffer_resource(std::pmr::null_memory_resource());
+    auto parser = argparse::ArgumentParser().memory_resource(&resource);
+    parser.add_argument("pos");
+
+    auto inputs = std::vector<std::vector<std::string>>();
+    for (auto i = 0; i < 100; ++i)
+    {
+        inputs.push_back({"a-rather-long-positional-value-" + std::to_string(i)});
+    }
+
+    auto const results = parser.parse_batch(inputs, 4);
+
+    REQUIRE(results.size() == 100);
+    for (auto i = 0; i < 100; ++i)
+    {
+        REQUIRE(results[static_cast<std::size_t>(i)].has_value());
+        CHECK(results[static_cast<std::size_t>(i)]->get_value("pos") == "a-rather-long-positional-value-" + std::to_string(i));
+    }
+}
@@ -0,0 +1,261 @@
+#include "argparse.hpp"
+
+#include "cstring_array.h"
+
+#include "doctest.h"
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+using namespace std::string_literals;
+
+namespace
+{
+    class TemporaryFile
+    {
+        public:
+            TemporaryFile(char const * name, std::string const & content)
+              : m_path(std::filesystem::temp_directory_path() / name)
+            {
+                std::ofstream(m_path, std::ios::binary) << content;
+            }
+
+            ~TemporaryFile()
+            {
+                std::filesystem::remove(m_path);
+            }
+
+            TemporaryFile(TemporaryFile const &) = delete;
+            TemporaryFile & operator=(TemporaryFile const &) = delete;
+
+            auto path() const -> std::filesystem::path const &
+            {
+                return m_path;
+            }
+
+        private:
+            std::filesystem::path m_path;
+    };
+}
+
+TEST_CASE("Parsing arguments with config file uses its values for arguments missing from the command line")
+{
+    auto const file = TemporaryFile("argparse_config_values.ini", "threads = 8\nname=server\n");
+
+    auto parser = argparse::ArgumentParser().config_file(file.path());
+    parser.add_argument("--threads").type<int>().default_(1);
+    parser.add_argument("--name").default_("client"s);
+    parser.add_argument("--port").type<int>().default_(80);
+
+    auto const args = parser.parse_args(1, cstr_arr{"prog"});
+
+    CHECK(args.get_value<int>("threads") == 8);
+    CHECK(args.get_value("name") == "server");
+    CHECK(args.get_value<int>("port") == 80);
+}
+
+TEST_CASE("Parsing arguments with config file prefers the command line over the config file")
+{
+    auto const file = TemporaryFile("argparse_config_precedence.ini", "threads = 8\n");
+
+    auto parser = argparse::ArgumentParser().config_file(file.path());
+    parser.add_argument("--threads").type<int>().default_(1);
+
+    auto const args = parser.parse_args(3, cstr_arr{"prog", "--threads", "4"});
+
+    CHECK(args.get_value<int>("threads") == 4);
+}
+
+TEST_CASE("Parsing arguments with config file matches keys by dest name")
+{
+    auto const file = TemporaryFile("argparse_config_dest.ini", "log_level = 3\nout = a.txt\n");
+
+    auto parser = argparse::ArgumentParser().config_file(file.path());
+    parser.add_argument("--log-level").type<int>();
+    parser.add_argument("-o", "--output").dest("out");
+
+    auto const args = parser.parse_args(1, cstr_arr{"prog"});
+
+    CHECK(args.get_value<int>("log_level") == 3);
+    CHECK(args.get_value("out") == "a.txt");
+}
+
+TEST_CASE("Parsing arguments with config file skips comments, blank lines and section headers")
+{
+    auto const file = TemporaryFile("argparse_config_comments.ini", "# comment\n; comment\n\n[server]\r\n  port = 8080  \r\nname = \"my server\"\r\n");
+
+    auto parser = argparse::ArgumentParser().config_file(file.path());
+    parser.add_argument("--port").type<int>();
+    parser.add_argument("--name");
+
+    auto const args = parser.parse_args(1, cstr_arr{"prog"});
+
+    CHECK(args.get_value<int>("port") == 8080);
+    CHECK(args.get_value("name") == "my server");
+}
+
+TEST_CASE("Parsing arguments with config file uses the last value of a repeated key")
+{
+    auto const file = TemporaryFile("argparse_config_repeated.ini", "port = 1\nport = 2\nport = 3");
+
+    auto parser = argparse::ArgumentParser().config_file(file.path());
+    parser.add_argument("--port").type<int>();
+
+    auto const args = parser.parse_args(1, cstr_arr{"prog"});
+
+    CHECK(args.get_value<int>("port") == 3);
+}
+
+TEST_CASE("Parsing arguments with config file sets flags and splits nargs values on spaces")
+{
+    auto const file = TemporaryFile("argparse_config_flags.ini", "verbose = true\nquiet = false\nsizes = 1 2 3\n");
+
+    auto parser = argparse::ArgumentParser().config_file(file.path());
+    parser.add_argument("--verbose").action(argparse::store_true);
+    parser.add_argument("--quiet").action(argparse::store_true);
+    parser.add_argument("--sizes").type<int>().nargs(3);
+
+    auto const args = parser.parse_args(1, cstr_arr{"prog"});
+
+    CHECK(args.get_value<bool>("verbose") == true);
+    CHECK(args.get_value<bool>("quiet") == false);
+    CHECK(args.get_value<std::vector<int>>("sizes") == std::vector<int>{1, 2, 3});
+}
+
+TEST_CASE("Parsing arguments with config file satisfies a required argument")
+{
+    auto const file = TemporaryFile("argparse_config_required.ini", "output = out.txt\n");
+
+    auto parser = argparse::ArgumentParser().config_file(file.path());
+    parser.add_argument("--output").required(true);
+
+    auto const args = parser.parse_args(1, cstr_arr{"prog"});
+
+    CHECK(args.get_value("output") == "out.txt");
+}
+
+TEST_CASE("Parsing arguments with config file stores config values in sparse mode")
+{
+    auto const file = TemporaryFile("argparse_config_sparse.ini", "threads = 8\n");
+
+    auto parser = argparse::ArgumentParser().sparse(true).config_file(file.path());
+    parser.add_argument("--threads").type<int>().default_(1);
+
+    auto const args = parser.parse_args(1, cstr_arr{"prog"});
+
+    CHECK(args.get_value<int>("threads") == 8);
+}
+
+TEST_CASE("Parsing arguments with config file reports invalid values")
+{
+    auto const file = TemporaryFile("argparse_config_invalid_value.ini", "threads = many\n");
+
+    auto parser = argparse::ArgumentParser().config_file(file.path()).handle(argparse::Handle::none);
+    parser.add_argument("--threads").type<int>();
+
+    CHECK_THROWS_WITH_AS(parser.parse_args(1, cstr_arr{"prog"}), "argument --threads: invalid value: 'many'", argparse::parsing_error);
+}
+
+TEST_CASE("Parsing arguments with config file reports unrecognised keys")
+{
+    auto const file = TemporaryFile("argparse_config_unrecognised.ini", "threads = 8\ncolour = red\n");
+
+    auto parser = argparse::ArgumentParser().config_file(file.path()).handle(argparse::Handle::none);
+    parser.add_argument("--threads").type<int>();
+
+    CHECK_THROWS_WITH_AS(parser.parse_args(1, cstr_arr{"prog"}), ("unrecognised key in '" + file.path().string() + "': colour").c_str(), argparse::parsing_error);
+}
+
+TEST_CASE("Parsing arguments with config file reports malformed lines")
+{
+    auto const file = TemporaryFile("argparse_config_malformed.ini", "threads = 8\nthreads\n");
+
+    auto parser = argparse::ArgumentParser().config_file(file.path()).handle(argparse::Handle::none);
+    parser.add_argument("--threads").type<int>();
+
+    CHECK_THROWS_WITH_AS(parser.parse_args(1, cstr_arr{"prog"}), (file.path().string() + ":2: expected 'key = value'").c_str(), argparse::parsing_error);
+}
+
+TEST_CASE("Parsing arguments with missing config file results in error")
+{
+    auto const path = std::filesystem::temp_directory_path() / "argparse_config_missing.ini";
+
+    auto parser = argparse::ArgumentParser().config_file(path).handle(argparse::Handle::none);
+    parser.add_argument("--threads").type<int>();
+
+    CHECK_THROWS_WITH_AS(parser.parse_args(1, cstr_arr{"prog"}), ("can't open '" + path.string() + "'").c_str(), argparse::parsing_error);
+}
+
+TEST_CASE("Parsing arguments with config file that is a directory results in error")
+{
+    auto const path = std::filesystem::temp_directory_path();
+
+    auto parser = argparse::ArgumentParser().config_file(path).handle(argparse::Handle::none);
+    parser.add_argument("--threads").type<int>();
+
+    CHECK_THROWS_WITH_AS(parser.parse_args(1, cstr_arr{"prog"}), ("can't open '" + path.string() + "'").c_str(), argparse::parsing_error);
+}
+
+TEST_CASE("Parsing arguments with config file reads the file only once")
+{
+    auto file = std::make_unique<TemporaryFile>("argparse_config_once.ini", "threads = 8\n");
+
+    auto parser = argparse::ArgumentParser().config_file(file->path());
+    parser.add_argument("--threads").type<int>().default_(1);
+
+    file.reset();
+
+    CHECK(parser.parse_args(1, cstr_arr{"prog"}).get_value<int>("threads") == 8);
+}
+
+TEST_CASE("Parsing arguments with config file uses new values after reload")
+{
+    auto const file = TemporaryFile("argparse_config_reload.ini", "threads = 8\n");
+
+    auto parser = argparse::ArgumentParser().config_file(file.path()).cache(4);
+    parser.add_argument("--threads").type<int>().default_(1);
+
+    CHECK(parser.parse_args_cached(1, cstr_arr{"prog"})->get_value<int>("threads") == 8);
+
+    std::ofstream(file.path(), std::ios::binary) << "threads = 16\n";
+
+    CHECK(parser.parse_args_cached(1, cstr_arr{"prog"})->get_value<int>("threads") == 8);
+
+    parser.reload_config_file();
+
+    CHECK(parser.parse_args_cached(1, cstr_arr{"prog"})->get_value<int>("threads") == 16);
+    CHECK(parser.parse_args(1, cstr_arr{"prog"}).get_value<int>("threads") == 16);
+}
+
+TEST_CASE("Parsing arguments with config file sets count arguments to the given number or boolean")
+{
+    auto const file = TemporaryFile("argparse_config_count.ini", "verbose = 3\nquiet = yes\ndebug = 0\n");
+
+    auto parser = argparse::ArgumentParser().config_file(file.path());
+    parser.add_argument("--verbose").action(argparse::count);
+    parser.add_argument("--quiet").action(argparse::count);
+    parser.add_argument("--debug").action(argparse::count).default_(0);
+
+    auto const args = parser.parse_args(1, cstr_arr{"prog"});
+
+    CHECK(args.get_value<int>("verbose") == 3);
+    CHECK(args.get_value<int>("quiet") == 1);
+    CHECK(args.get_value<int>("debug") == 0);
+}
+
+TEST_CASE("Parsing arguments with config file rejects count values that are neither non-negative numbers nor booleans")
+{
+    for (auto const & value : {"abc"s, "-2"s, "1.5"s})
+    {
+        auto const file = TemporaryFile("argparse_config_count_invalid.ini", "verbose = " + value + "\n");
+
+        auto parser = argparse::ArgumentParser().config_file(file.path()).handle(argparse::Handle::none);
+        parser.add_argument("--verbose").action(argparse::count);
+
+        CHECK_THROWS_WITH_AS(parser.parse_args(1, cstr_arr{"prog"}), ("argument --verbose: invalid value: '" + value + "'").c_str(), argparse::parsing_error);
+    }
+}
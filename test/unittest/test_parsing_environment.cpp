@@ -0,0 +1,197 @@
+#include "argparse.hpp"
+
+#include "cstring_array.h"
+
+#include "doctest.h"
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+
+using namespace std::string_literals;
+
+namespace
+{
+    class EnvironmentVariable
+    {
+        public:
+            EnvironmentVariable(char const * name, char const * value)
+              : m_name(name)
+            {
+#if defined(_WIN32)
+                _putenv_s(m_name, value);
+#else
+                setenv(m_name, value, 1);
+#endif
+            }
+
+            ~EnvironmentVariable()
+            {
+#if defined(_WIN32)
+                _putenv_s(m_name, "");
+#else
+                unsetenv(m_name);
+#endif
+            }
+
+            EnvironmentVariable(EnvironmentVariable const &) = delete;
+            EnvironmentVariable & operator=(EnvironmentVariable const &) = delete;
+
+        private:
+            char const * m_name;
+    };
+}
+
+TEST_CASE("Adding a positional argument with env option results in error")
+{
+    auto parser = argparse::ArgumentParser();
+
+    CHECK_THROWS_WITH_AS(parser.add_argument("pos").env("ARGPARSE_TEST_POS"), "'env' is an invalid argument for positionals", argparse::option_error);
+}
+
+TEST_CASE("Adding a help or version argument with env option results in error")
+{
+    auto parser = argparse::ArgumentParser().add_help(false);
+
+    CHECK_THROWS_WITH_AS(parser.add_argument("-h").action(argparse::help).env("ARGPARSE_TEST_HELP"), "'env' is an invalid argument for help and version actions", argparse::option_error);
+    CHECK_THROWS_WITH_AS(parser.add_argument("-v").action(argparse::version).env("ARGPARSE_TEST_VERSION"), "'env' is an invalid argument for help and version actions", argparse::option_error);
+}
+
+TEST_CASE("Parsing an optional argument with env option uses the environment variable when argument is missing")
+{
+    auto const variable = EnvironmentVariable("ARGPARSE_TEST_THREADS", "8");
+
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("--threads").type<int>().env("ARGPARSE_TEST_THREADS").default_(1);
+
+    auto const args = parser.parse_args(1, cstr_arr{"prog"});
+
+    CHECK(args.get_value<int>("threads") == 8);
+}
+
+TEST_CASE("Parsing an optional argument with env option prefers the command line over the environment variable")
+{
+    auto const variable = EnvironmentVariable("ARGPARSE_TEST_THREADS", "8");
+
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("--threads").type<int>().env("ARGPARSE_TEST_THREADS").default_(1);
+
+    auto const args = parser.parse_args(3, cstr_arr{"prog", "--threads", "4"});
+
+    CHECK(args.get_value<int>("threads") == 4);
+}
+
+TEST_CASE("Parsing an optional argument with env option uses the default when environment variable is not set")
+{
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("--threads").type<int>().env("ARGPARSE_TEST_UNSET").default_(1);
+
+    auto const args = parser.parse_args(1, cstr_arr{"prog"});
+
+    CHECK(args.get_value<int>("threads") == 1);
+}
+
+TEST_CASE("Parsing an optional argument with env option reads the environment on every parse")
+{
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("--name").env("ARGPARSE_TEST_NAME").default_("none"s);
+
+    {
+        auto const variable = EnvironmentVariable("ARGPARSE_TEST_NAME", "first");
+        CHECK(parser.parse_args(1, cstr_arr{"prog"}).get_value("name") == "first");
+    }
+    {
+        auto const variable = EnvironmentVariable("ARGPARSE_TEST_NAME", "second");
+        CHECK(parser.parse_args(1, cstr_arr{"prog"}).get_value("name") == "second");
+    }
+
+    CHECK(parser.parse_args(1, cstr_arr{"prog"}).get_value("name") == "none");
+}
+
+TEST_CASE("Parsing an optional argument with env option satisfies a required argument")
+{
+    auto const variable = EnvironmentVariable("ARGPARSE_TEST_OUTPUT", "out.txt");
+
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("--output").required(true).env("ARGPARSE_TEST_OUTPUT");
+
+    auto const args = parser.parse_args(1, cstr_arr{"prog"});
+
+    CHECK(args.get_value("output") == "out.txt");
+}
+
+TEST_CASE("Parsing an optional argument with env option and nargs splits the environment variable on spaces")
+{
+    auto const variable = EnvironmentVariable("ARGPARSE_TEST_SIZES", "1  2 3");
+
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("--sizes").type<int>().nargs(argparse::zero_or_more).env("ARGPARSE_TEST_SIZES");
+
+    auto const args = parser.parse_args(1, cstr_arr{"prog"});
+
+    CHECK(args.get_value<std::vector<int>>("sizes") == std::vector<int>{1, 2, 3});
+}
+
+TEST_CASE("Parsing an optional argument with env option and nargs splits the environment variable like a shell")
+{
+    auto const variable = EnvironmentVariable("ARGPARSE_TEST_FILES", "\"a b\" c 'd e'");
+
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("--files").nargs(argparse::zero_or_more).env("ARGPARSE_TEST_FILES");
+
+    auto const args = parser.parse_args(1, cstr_arr{"prog"});
+
+    CHECK(args.get_value<std::vector<std::string>>("files") == std::vector<std::string>{"a b", "c", "d e"});
+}
+
+TEST_CASE("Parsing an optional argument with env option and nargs reports unterminated quotes in the environment variable")
+{
+    auto const variable = EnvironmentVariable("ARGPARSE_TEST_FILES", "\"a b");
+
+    auto parser = argparse::ArgumentParser().handle(argparse::Handle::none);
+    parser.add_argument("--files").nargs(argparse::zero_or_more).env("ARGPARSE_TEST_FILES");
+
+    CHECK_THROWS_WITH_AS(parser.parse_args(1, cstr_arr{"prog"}), "argument --files: no closing quotation", argparse::parsing_error);
+}
+
+TEST_CASE("Parsing an optional argument with env option checks the environment variable value")
+{
+    auto const variable = EnvironmentVariable("ARGPARSE_TEST_LEVEL", "high");
+
+    auto parser = argparse::ArgumentParser().handle(argparse::Handle::none);
+    parser.add_argument("--level").type<int>().env("ARGPARSE_TEST_LEVEL");
+
+    CHECK_THROWS_WITH_AS(parser.parse_args(1, cstr_arr{"prog"}), "argument --level: invalid value: 'high'", argparse::parsing_error);
+}
+
+TEST_CASE("Parsing a flag with env option sets the flag unless the environment variable is falsy")
+{
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("--verbose").action(argparse::store_true).env("ARGPARSE_TEST_VERBOSE");
+
+    {
+        auto const variable = EnvironmentVariable("ARGPARSE_TEST_VERBOSE", "1");
+        CHECK(parser.parse_args(1, cstr_arr{"prog"}).get_value<bool>("verbose") == true);
+    }
+    {
+        auto const variable = EnvironmentVariable("ARGPARSE_TEST_VERBOSE", "0");
+        CHECK(parser.parse_args(1, cstr_arr{"prog"}).get_value<bool>("verbose") == false);
+    }
+    {
+        auto const variable = EnvironmentVariable("ARGPARSE_TEST_VERBOSE", "false");
+        CHECK(parser.parse_args(1, cstr_arr{"prog"}).get_value<bool>("verbose") == false);
+    }
+}
+
+TEST_CASE("Parsing an optional argument with env option in sparse mode stores the environment value")
+{
+    auto const variable = EnvironmentVariable("ARGPARSE_TEST_THREADS", "8");
+
+    auto parser = argparse::ArgumentParser().sparse(true);
+    parser.add_argument("--threads").type<int>().env("ARGPARSE_TEST_THREADS").default_(1);
+
+    auto const args = parser.parse_args(1, cstr_arr{"prog"});
+
+    CHECK(args.get_value<int>("threads") == 8);
+}
@@ -5,8 +5,14 @@
 
 #include "doctest.h"
 
+#include <algorithm>
+#include <any>
+#include <cctype>
+#include <limits>
+#include <optional>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 
 using namespace std::string_literals;
@@ -2959,3 +2965,89 @@ TEST_CASE_TEMPLATE("Parsing an optional argument yields correct value for negati
         CHECK(args.get_value<T>("number") == T(-1.125));
     }
 }
+
+TEST_CASE("Parsing an optional argument with a large set of choices accepts any of the values")
+{
+    auto parser = argparse::ArgumentParser().handle(argparse::Handle::none);
+    auto choices = std::vector<std::any>();
+    for (auto i = 1000; i > 0; --i)
+    {
+        choices.push_back(std::to_string(i));
+    }
+    parser.add_argument("-o").choices(choices);
+
+    CHECK(parser.parse_args(3, cstr_arr{"prog", "-o", "1"}).get_value("o") == "1");
+    CHECK(parser.parse_args(3, cstr_arr{"prog", "-o", "500"}).get_value("o") == "500");
+    CHECK(parser.parse_args(3, cstr_arr{"prog", "-o", "1000"}).get_value("o") == "1000");
+    CHECK_THROWS_AS(parser.parse_args(3, cstr_arr{"prog", "-o", "1001"}), argparse::parsing_error);
+}
+
+TEST_CASE("Parsing an optional argument with choices lists them in the given order on incorrect value")
+{
+    auto parser = argparse::ArgumentParser().handle(argparse::Handle::none);
+    parser.add_argument("-o").choices({3, 1, 2}).type<int>();
+
+    CHECK_THROWS_WITH_AS(parser.parse_args(3, cstr_arr{"prog", "-o", "4"}), "argument -o: invalid choice: 4 (choose from 3, 1, 2)", argparse::parsing_error);
+}
+
+TEST_CASE("Parsing an optional argument of bool type with choices accepts one of the values")
+{
+    auto parser = argparse::ArgumentParser().handle(argparse::Handle::none);
+    parser.add_argument("-o").type<bool>().choices({true});
+
+    CHECK(parser.parse_args(3, cstr_arr{"prog", "-o", "1"}).get_value<bool>("o") == true);
+    CHECK_THROWS_WITH_AS(parser.parse_args(3, cstr_arr{"prog", "-o", "0"}), "argument -o: invalid choice: 0 (choose from 1)", argparse::parsing_error);
+}
+
+TEST_CASE("Parsing an optional argument of floating point type with NaN among choices accepts the other values")
+{
+    auto parser = argparse::ArgumentParser().handle(argparse::Handle::none);
+    parser.add_argument("-o").type<double>().choices({2.5, std::numeric_limits<double>::quiet_NaN(), 0.5, 1.5});
+
+    CHECK(parser.parse_args(3, cstr_arr{"prog", "-o", "0.5"}).get_value<double>("o") == 0.5);
+    CHECK(parser.parse_args(3, cstr_arr{"prog", "-o", "1.5"}).get_value<double>("o") == 1.5);
+    CHECK(parser.parse_args(3, cstr_arr{"prog", "-o", "2.5"}).get_value<double>("o") == 2.5);
+    CHECK_THROWS_AS(parser.parse_args(3, cstr_arr{"prog", "-o", "3.5"}), argparse::parsing_error);
+}
+
+namespace
+{
+    struct CaseInsensitive
+    {
+        std::string text;
+
+        auto operator<=>(CaseInsensitive const &) const = default;
+    };
+}
+
+namespace argparse
+{
+template<>
+class Converter<CaseInsensitive>
+{
+    public:
+        auto from_string(std::string const & s) const -> std::optional<CaseInsensitive>
+        {
+            return CaseInsensitive{s};
+        }
+
+        auto to_string(CaseInsensitive const & t) const -> std::string
+        {
+            return t.text;
+        }
+
+        auto are_equal(CaseInsensitive const & lhs, CaseInsensitive const & rhs) const -> bool
+        {
+            return std::ranges::equal(lhs.text, rhs.text, [](char l, char r) { return std::tolower(static_cast<unsigned char>(l)) == std::tolower(static_cast<unsigned char>(r)); });
+        }
+};
+}
+
+TEST_CASE("Parsing an optional argument with choices compares them with the converter's are_equal")
+{
+    auto parser = argparse::ArgumentParser().handle(argparse::Handle::none);
+    parser.add_argument("-o").type<CaseInsensitive>().choices({CaseInsensitive{"foo"}, CaseInsensitive{"bar"}});
+
+    CHECK(parser.parse_args(3, cstr_arr{"prog", "-o", "FOO"}).get_value<CaseInsensitive>("o").text == "FOO");
+    CHECK_THROWS_AS(parser.parse_args(3, cstr_arr{"prog", "-o", "baz"}), argparse::parsing_error);
+}
@@ -0,0 +1,481 @@
+#include "argparse.hpp"
+
+#include "cstring_array.h"
+#include "custom.h"
+
+#include "doctest.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+using namespace std::string_view_literals;
+
+TEST_CASE("Serialised parameters can be read in place")
+{
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("pos");
+    parser.add_argument("-i").type<int>();
+    parser.add_argument("-u").type<unsigned long>();
+    parser.add_argument("-d").type<double>();
+    parser.add_argument("-f").action(argparse::store_true);
+    parser.add_argument("-n").type<long long>().nargs(3);
+    parser.add_argument("-s").nargs(argparse::zero_or_more);
+    parser.add_argument("-e");
+
+    auto const bytes = parser.parse_args(15, cstr_arr{"prog", "text", "-i", "-7", "-u", "8", "-d", "0.5", "-f", "-n", "1", "2", "3", "-s", "a"}).serialize();
+    auto const view = argparse::ArgumentParser::ParametersView(bytes);
+
+    CHECK(view.get_value("pos") == "text");
+    CHECK(view.get_value<int>("i") == -7);
+    CHECK(view.get_value<unsigned long>("u") == 8);
+    CHECK(view.get_value<double>("d") == 0.5);
+    CHECK(view.get_value<bool>("f") == true);
+    CHECK(view.get_value<bool>("help") == false);
+    CHECK(std::ranges::equal(view.get_span<long long>("n"), std::vector<long long>{1, 2, 3}));
+    CHECK(std::ranges::equal(view.get_strings("s"), std::vector{"a"sv}));
+    CHECK(view.has_value("e") == false);
+    CHECK(view.has_value("i") == true);
+}
+
+TEST_CASE("Serialised parameters keep multiple strings")
+{
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("-s").action(argparse::append);
+
+    auto const bytes = parser.parse_args(7, cstr_arr{"prog", "-s", "one", "-s", "", "-s", "three"}).serialize();
+    auto const view = argparse::ArgumentParser::ParametersView(bytes);
+
+    CHECK(std::ranges::equal(view.get_strings("s"), std::vector{"one"sv, ""sv, "three"sv}));
+}
+
+TEST_CASE("Serialised parameters in sparse mode include default values")
+{
+    auto parser = argparse::ArgumentParser().sparse(true);
+    parser.add_argument("-a").default_(std::string("default"));
+    parser.add_argument("-b");
+
+    auto const bytes = parser.parse_args(3, cstr_arr{"prog", "-b", "given"}).serialize();
+    auto const view = argparse::ArgumentParser::ParametersView(bytes);
+
+    CHECK(view.get_value("a") == "default");
+    CHECK(view.get_value("b") == "given");
+}
+
+TEST_CASE("Reading serialised parameters with wrong name or type throws an exception")
+{
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("-i").type<int>();
+
+    auto const bytes = parser.parse_args(3, cstr_arr{"prog", "-i", "1"}).serialize();
+    auto const view = argparse::ArgumentParser::ParametersView(bytes);
+
+    CHECK_THROWS_WITH_AS(view.get_value<int>("x"), "no such argument: 'x'", argparse::name_error);
+    CHECK_THROWS_AS(view.get_value("i"), argparse::type_error);
+    CHECK_THROWS_AS(view.get_value<short>("i"), argparse::type_error);
+    CHECK_THROWS_AS(view.get_span<int>("i"), argparse::type_error);
+}
+
+TEST_CASE("Reading invalid serialised parameters throws an exception")
+{
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("-s");
+
+    auto bytes = parser.parse_args(3, cstr_arr{"prog", "-s", "value"}).serialize();
+
+    CHECK_THROWS_WITH_AS(argparse::ArgumentParser::ParametersView(std::span(bytes).first(8)), "invalid parameters buffer", argparse::buffer_error);
+    CHECK_THROWS_WITH_AS(argparse::ArgumentParser::ParametersView(std::span(bytes).first(bytes.size() - 1)), "invalid parameters buffer", argparse::buffer_error);
+
+    bytes.front() = std::byte(0);
+    CHECK_THROWS_WITH_AS(argparse::ArgumentParser::ParametersView(std::span(bytes)), "invalid parameters buffer", argparse::buffer_error);
+}
+
+namespace
+{
+    constexpr auto entry_offset = std::size_t(16);
+    constexpr auto value_offset_field = std::size_t(8);
+    constexpr auto value_size_field = std::size_t(12);
+    constexpr auto kind_field = std::size_t(16);
+    constexpr auto width_field = std::size_t(18);
+    constexpr auto vector_field = std::size_t(19);
+
+    template<typename T>
+    auto patch(std::vector<std::byte> bytes, std::size_t field, T value) -> std::vector<std::byte>
+    {
+        std::memcpy(bytes.data() + entry_offset + field, &value, sizeof(value));
+        return bytes;
+    }
+
+    auto get_value_offset(std::vector<std::byte> const & bytes) -> std::uint32_t
+    {
+        auto offset = std::uint32_t();
+        std::memcpy(&offset, bytes.data() + entry_offset + value_offset_field, sizeof(offset));
+        return offset;
+    }
+}
+
+TEST_CASE("Reading serialised parameters with corrupted entries throws an exception")
+{
+    auto parser = argparse::ArgumentParser().add_help(false);
+    parser.add_argument("-i").type<int>();
+
+    auto const bytes = parser.parse_args(3, cstr_arr{"prog", "-i", "2"}).serialize();
+    auto const offset = get_value_offset(bytes);
+
+    CHECK_NOTHROW(argparse::ArgumentParser::ParametersView(std::span(bytes)));
+    CHECK_THROWS_WITH_AS(argparse::ArgumentParser::ParametersView(std::span<std::byte const>(patch(bytes, width_field, std::uint8_t(3)))), "invalid parameters buffer", argparse::buffer_error);
+    CHECK_THROWS_WITH_AS(argparse::ArgumentParser::ParametersView(std::span<std::byte const>(patch(bytes, width_field, std::uint8_t(16)))), "invalid parameters buffer", argparse::buffer_error);
+    CHECK_THROWS_WITH_AS(argparse::ArgumentParser::ParametersView(std::span<std::byte const>(patch(bytes, value_size_field, std::uint32_t(0)))), "invalid parameters buffer", argparse::buffer_error);
+    CHECK_THROWS_WITH_AS(argparse::ArgumentParser::ParametersView(std::span<std::byte const>(patch(bytes, value_offset_field, std::uint32_t(offset - 2)))), "invalid parameters buffer", argparse::buffer_error);
+    CHECK_THROWS_WITH_AS(argparse::ArgumentParser::ParametersView(std::span<std::byte const>(patch(bytes, kind_field, std::uint16_t(5)))), "invalid parameters buffer", argparse::buffer_error);
+    CHECK_THROWS_WITH_AS(argparse::ArgumentParser::ParametersView(std::span<std::byte const>(patch(bytes, kind_field, std::uint16_t(42)))), "invalid parameters buffer", argparse::buffer_error);
+    CHECK_THROWS_WITH_AS(argparse::ArgumentParser::ParametersView(std::span<std::byte const>(patch(bytes, vector_field, std::uint8_t(2)))), "invalid parameters buffer", argparse::buffer_error);
+    CHECK_THROWS_WITH_AS(argparse::ArgumentParser::ParametersView(std::span<std::byte const>(patch(patch(bytes, kind_field, std::uint16_t(1)), width_field, std::uint8_t(1)))), "invalid parameters buffer", argparse::buffer_error);
+}
+
+TEST_CASE("Reading serialised parameters with a string entry of wrong width throws an exception")
+{
+    auto parser = argparse::ArgumentParser().add_help(false);
+    parser.add_argument("-s");
+
+    auto const bytes = parser.parse_args(3, cstr_arr{"prog", "-s", "value"}).serialize();
+
+    CHECK_THROWS_WITH_AS(argparse::ArgumentParser::ParametersView(std::span<std::byte const>(patch(bytes, width_field, std::uint8_t(4)))), "invalid parameters buffer", argparse::buffer_error);
+}
+
+TEST_CASE("Reading a span from a misaligned buffer throws an exception")
+{
+    auto parser = argparse::ArgumentParser().add_help(false);
+    parser.add_argument("-n").type<long long>().nargs(2);
+
+    auto const bytes = parser.parse_args(4, cstr_arr{"prog", "-n", "1", "2"}).serialize();
+
+    auto storage = std::vector<std::uint64_t>(bytes.size() / sizeof(std::uint64_t) + 2);
+    auto const shifted = std::span(reinterpret_cast<std::byte *>(storage.data()) + 1, bytes.size());
+    std::ranges::copy(bytes, shifted.begin());
+
+    auto const view = argparse::ArgumentParser::ParametersView(shifted);
+
+    CHECK_THROWS_WITH_AS((void) view.get_span<long long>("n"), "misaligned parameters buffer", argparse::buffer_error);
+}
+
+TEST_CASE("Serialising parameters of unsupported type throws an exception")
+{
+    struct Custom {};
+
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("-c").action(argparse::store_const).const_(Custom());
+
+    auto const args = parser.parse_args(2, cstr_arr{"prog", "-c"});
+
+    CHECK_THROWS_AS((void) args.serialize(), argparse::type_error);
+}
+
+namespace
+{
+    auto get_args(argparse::ArgumentParser::Argv const & argv) -> std::vector<std::string_view>
+    {
+        return std::span(argv.argv(), static_cast<std::size_t>(argv.argc())) | std::views::transform([](char const * arg) { return std::string_view(arg); }) | std::ranges::to<std::vector>();
+    }
+}
+
+TEST_CASE("Unparsing parameters skips default values")
+{
+    auto parser = argparse::ArgumentParser().prog("prog");
+    parser.add_argument("-a").default_(std::string("a"));
+    parser.add_argument("-b").action(argparse::store_true);
+    parser.add_argument("-c").action(argparse::count);
+    parser.add_argument("-i").type<int>().default_(5);
+
+    auto const argv = parser.to_argv(parser.parse_args(3, cstr_arr{"prog", "-i", "5"}));
+
+    CHECK(get_args(argv) == std::vector{"prog"sv});
+    CHECK(argv.argv()[argv.argc()] == nullptr);
+}
+
+TEST_CASE("Unparsing parameters produces arguments which parse to the same values")
+{
+    auto parser = argparse::ArgumentParser().prog("prog");
+    parser.add_argument("pos");
+    parser.add_argument("--name");
+    parser.add_argument("-t", "--true").action(argparse::store_true);
+    parser.add_argument("-f").action(argparse::store_false);
+    parser.add_argument("-v").action(argparse::count);
+    parser.add_argument("-c").action(argparse::store_const).const_(std::string("const"));
+    parser.add_argument("-n").type<double>().nargs(2);
+    parser.add_argument("--list").type<int>().nargs(argparse::zero_or_more);
+    parser.add_argument("-a").action(argparse::append);
+
+    auto const args = parser.parse_args(18, cstr_arr{"prog", "--list", "1", "-2", "--name", "value", "-t", "-f", "-vv", "-c", "-n", "0.25", "1e10", "-a", "x", "-a-y", "--", "-pos"});
+    auto const argv = parser.to_argv(args);
+
+    CHECK(get_args(argv) == std::vector{"prog"sv, "--name"sv, "value"sv, "-t"sv, "-f"sv, "-v"sv, "-v"sv, "-c"sv, "-n"sv, "0.25"sv, "1e+10"sv, "--list"sv, "1"sv, "-2"sv, "-a"sv, "x"sv, "-a-y"sv, "--"sv, "-pos"sv});
+
+    auto const reparsed = parser.parse_args(argv.argc(), argv.argv());
+
+    CHECK(reparsed.get_value("pos") == "-pos");
+    CHECK(reparsed.get_value("name") == "value");
+    CHECK(reparsed.get_value<bool>("true") == true);
+    CHECK(reparsed.get_value<bool>("f") == false);
+    CHECK(reparsed.get_value<int>("v") == 2);
+    CHECK(reparsed.get_value("c") == "const");
+    CHECK(reparsed.get_value<std::vector<double>>("n") == std::vector{0.25, 1e10});
+    CHECK(reparsed.get_value<std::vector<int>>("list") == std::vector{1, -2});
+    CHECK(reparsed.get_value<std::vector<std::string>>("a") == std::vector<std::string>{"x", "-y"});
+}
+
+TEST_CASE("Unparsing parameters joins long option with value starting with dash")
+{
+    auto parser = argparse::ArgumentParser().prog("prog");
+    parser.add_argument("--name");
+
+    auto const argv = parser.to_argv(parser.parse_args(2, cstr_arr{"prog", "--name=-value"}));
+
+    CHECK(get_args(argv) == std::vector{"prog"sv, "--name=-value"sv});
+    CHECK(parser.parse_args(argv.argc(), argv.argv()).get_value("name") == "-value");
+}
+
+TEST_CASE("Unparsing parameters compares const and count values by their own type")
+{
+    auto parser = argparse::ArgumentParser().prog("prog");
+    parser.add_argument("-c").action(argparse::store_const).const_(5).default_(1);
+    parser.add_argument("-v").action(argparse::count).default_(0);
+    parser.add_argument("-t").action(argparse::store_true).default_(false);
+
+    auto const defaults = parser.to_argv(parser.parse_args(1, cstr_arr{"prog"}));
+    auto const given = parser.to_argv(parser.parse_args(4, cstr_arr{"prog", "-c", "-vv", "-t"}));
+
+    CHECK(get_args(defaults) == std::vector{"prog"sv});
+    CHECK(get_args(given) == std::vector{"prog"sv, "-c"sv, "-v"sv, "-v"sv, "-t"sv});
+
+    auto const reparsed = parser.parse_args(given.argc(), given.argv());
+
+    CHECK(reparsed.get_value<int>("c") == 5);
+    CHECK(reparsed.get_value<int>("v") == 2);
+    CHECK(reparsed.get_value<bool>("t") == true);
+    CHECK(parser.parse_args(defaults.argc(), defaults.argv()).get_value<int>("c") == 1);
+}
+
+TEST_CASE("Unparsing parameters keeps required options equal to their default")
+{
+    auto parser = argparse::ArgumentParser().prog("prog");
+    parser.add_argument("--mode").required(true).default_(std::string("fast"));
+    parser.add_argument("--level").type<int>().required(true).default_(1);
+    parser.add_argument("-c").action(argparse::store_const).const_(5).default_(5).required(true);
+
+    auto const args = parser.parse_args(6, cstr_arr{"prog", "--mode", "fast", "--level", "1", "-c"});
+    auto const argv = parser.to_argv(args);
+
+    CHECK(get_args(argv) == std::vector{"prog"sv, "--mode"sv, "fast"sv, "--level"sv, "1"sv, "-c"sv});
+
+    auto const reparsed = parser.parse_args(argv.argc(), argv.argv());
+
+    CHECK(reparsed.get_value("mode") == args.get_value("mode"));
+    CHECK(reparsed.get_value<int>("level") == args.get_value<int>("level"));
+    CHECK(reparsed.get_value<int>("c") == args.get_value<int>("c"));
+    CHECK(parser.fingerprint(reparsed) == parser.fingerprint(args));
+}
+
+TEST_CASE("Unparsing parameters rejects values of option with nargs starting with dash")
+{
+    auto source = argparse::ArgumentParser().prog("prog");
+    source.add_argument("--opt");
+    source.add_argument("--list").action(argparse::append);
+
+    auto optional = argparse::ArgumentParser().prog("prog");
+    optional.add_argument("--opt").nargs(argparse::zero_or_one);
+
+    auto list = argparse::ArgumentParser().prog("prog");
+    list.add_argument("--list").nargs(argparse::zero_or_more);
+
+    auto const args = source.parse_args(3, cstr_arr{"prog", "--opt=-x", "--list=-y"});
+
+    CHECK_THROWS_WITH_AS(optional.to_argv(args), "argument --opt: values starting with '-' cannot be unparsed", argparse::type_error);
+    CHECK_THROWS_WITH_AS(list.to_argv(args), "argument --list: values starting with '-' cannot be unparsed", argparse::type_error);
+
+    auto const negative = source.parse_args(2, cstr_arr{"prog", "--opt=-1"});
+    auto const argv = optional.to_argv(negative);
+
+    CHECK(get_args(argv) == std::vector{"prog"sv, "--opt"sv, "-1"sv});
+    CHECK(optional.parse_args(argv.argc(), argv.argv()).get_value("opt") == "-1");
+}
+
+TEST_CASE("Unparsed arguments stay valid after move")
+{
+    auto parser = argparse::ArgumentParser().prog("prog");
+    parser.add_argument("--name");
+
+    auto argv = parser.to_argv(parser.parse_args(3, cstr_arr{"prog", "--name", "value"}));
+    auto const moved = std::move(argv);
+
+    CHECK(get_args(moved) == std::vector{"prog"sv, "--name"sv, "value"sv});
+}
+
+TEST_CASE("MurmurHash3 produces reference values")
+{
+    CHECK(argparse::detail::murmur_hash3(std::span<char const>()) == argparse::Fingerprint{0, 0});
+    CHECK(argparse::detail::murmur_hash3(std::span("hello"sv)).to_string() == "5b1e906a48ae1d19cbd8a7b341bd9b02");
+    CHECK(argparse::detail::murmur_hash3(std::span("The quick brown fox jumps over the lazy dog"sv)).to_string() == "7a433ca9c49a9347e34bbc7bbc071b6c");
+}
+
+TEST_CASE("Fingerprint does not depend on order and form of arguments")
+{
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("--a").type<int>();
+    parser.add_argument("--b").type<int>();
+
+    auto const fingerprint1 = parser.fingerprint(parser.parse_args(5, cstr_arr{"prog", "--a", "1", "--b", "2"}));
+    auto const fingerprint2 = parser.fingerprint(parser.parse_args(4, cstr_arr{"prog", "--b=2", "--a", "01"}));
+
+    CHECK(fingerprint1 == fingerprint2);
+}
+
+TEST_CASE("Fingerprint depends on values")
+{
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("pos").nargs(argparse::zero_or_more);
+    parser.add_argument("--a").type<int>();
+    parser.add_argument("-f").action(argparse::store_true);
+
+    auto const fingerprint = [&](auto const & args) { return parser.fingerprint(parser.parse_args(static_cast<int>(args.size()), args.data())); };
+
+    auto const fingerprints = std::vector{
+        fingerprint(std::array{"prog"}),
+        fingerprint(std::array{"prog", "--a", "1"}),
+        fingerprint(std::array{"prog", "--a", "2"}),
+        fingerprint(std::array{"prog", "-f"}),
+        fingerprint(std::array{"prog", "ab"}),
+        fingerprint(std::array{"prog", "a", "b"})};
+
+    for (auto i = std::size_t(0); i != fingerprints.size(); ++i)
+    {
+        for (auto j = i + 1; j != fingerprints.size(); ++j)
+        {
+            CHECK(fingerprints[i] != fingerprints[j]);
+        }
+    }
+}
+
+TEST_CASE("Fingerprint distinguishes positional values from an option with the same name")
+{
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("pos").nargs(argparse::zero_or_more);
+    parser.add_argument("-q");
+
+    auto const positional = parser.parse_args(3, cstr_arr{"prog", "q", "v"});
+    auto const optional = parser.parse_args(3, cstr_arr{"prog", "-q", "v"});
+
+    CHECK(parser.fingerprint(positional) != parser.fingerprint(optional));
+}
+
+TEST_CASE("Fingerprint distinguishes empty vector from missing value")
+{
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("--list").nargs(argparse::zero_or_more);
+
+    CHECK(parser.fingerprint(parser.parse_args(2, cstr_arr{"prog", "--list"})) != parser.fingerprint(parser.parse_args(1, cstr_arr{"prog"})));
+}
+
+TEST_CASE("Fingerprint does not change when option with default is added to schema")
+{
+    auto parser1 = argparse::ArgumentParser();
+    parser1.add_argument("--a");
+
+    auto parser2 = argparse::ArgumentParser();
+    parser2.add_argument("--a");
+    parser2.add_argument("--level").type<int>().default_(3);
+    parser2.add_argument("--verbose").action(argparse::store_true);
+    parser2.add_argument("--new");
+
+    auto const fingerprint1 = parser1.fingerprint(parser1.parse_args(3, cstr_arr{"prog", "--a", "x"}));
+
+    CHECK(parser2.fingerprint(parser2.parse_args(3, cstr_arr{"prog", "--a", "x"})) == fingerprint1);
+    CHECK(parser2.fingerprint(parser2.parse_args(5, cstr_arr{"prog", "--a", "x", "--level", "3"})) == fingerprint1);
+    CHECK(parser2.fingerprint(parser2.parse_args(5, cstr_arr{"prog", "--a", "x", "--level", "4"})) != fingerprint1);
+}
+
+TEST_CASE("Parameters are written as JSON")
+{
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("pos");
+    parser.add_argument("-i").type<int>();
+    parser.add_argument("-d").type<double>();
+    parser.add_argument("-l").type<long>().nargs(argparse::zero_or_more);
+    parser.add_argument("-f").action(argparse::store_true);
+    parser.add_argument("-c").action(argparse::count);
+    parser.add_argument("-s");
+
+    auto const args = parser.parse_args(11, cstr_arr{"prog", "text", "-i", "-3", "-d", "0.5", "-l", "1", "2", "-cc", "-f"});
+
+    CHECK(parser.to_json(args) == R"({"c":2,"d":0.5,"f":true,"help":false,"i":-3,"l":[1,2],"pos":"text","s":null})");
+}
+
+TEST_CASE("Strings written as JSON are escaped")
+{
+    auto parser = argparse::ArgumentParser().add_help(false);
+    parser.add_argument("pos");
+
+    auto const args = parser.parse_args(2, cstr_arr{"prog", "a\"b\\c\nd\te\x01\xc3\xa9"});
+
+    CHECK(parser.to_json(args) == "{\"pos\":\"a\\\"b\\\\c\\nd\\te\\u0001\xc3\xa9\"}");
+}
+
+TEST_CASE("Invalid UTF-8 in strings written as JSON is replaced")
+{
+    auto parser = argparse::ArgumentParser().add_help(false);
+    parser.add_argument("pos");
+
+    auto const json = [&](char const * arg) { return parser.to_json(parser.parse_args(2, cstr_arr{"prog", arg})); };
+
+    CHECK(json("a\xff" "b") == "{\"pos\":\"a\\ufffdb\"}");
+    CHECK(json("\xc3") == "{\"pos\":\"\\ufffd\"}");
+    CHECK(json("\xc0\xaf") == "{\"pos\":\"\\ufffd\\ufffd\"}");
+    CHECK(json("\xed\xa0\x80") == "{\"pos\":\"\\ufffd\\ufffd\\ufffd\"}");
+    CHECK(json("\xe2\x82\xac\xf0\x9f\x98\x80") == "{\"pos\":\"\xe2\x82\xac\xf0\x9f\x98\x80\"}");
+}
+
+TEST_CASE("Parameters are written as JSON to output iterator")
+{
+    auto parser = argparse::ArgumentParser().add_help(false);
+    parser.add_argument("-b").type<bool>();
+    parser.add_argument("-n").type<double>().default_(std::numeric_limits<double>::quiet_NaN());
+
+    auto const args = parser.parse_args(3, cstr_arr{"prog", "-b", "1"});
+
+    auto json = std::vector<char>();
+    (void) parser.to_json(args, std::back_inserter(json));
+
+    CHECK(std::string_view(json.data(), json.size()) == R"({"b":true,"n":null})");
+}
+
+TEST_CASE("Defaults and const values of a type other than the argument type are written as JSON")
+{
+    auto parser = argparse::ArgumentParser().add_help(false);
+    parser.add_argument("--n").type<int>().default_(std::string("auto"));
+    parser.add_argument("--ratio").default_(0.5);
+    parser.add_argument("--sizes").type<int>().nargs(argparse::zero_or_more).default_(std::vector<std::string>{"a", "b"});
+    parser.add_argument("-c").action(argparse::store_const).const_(std::vector<double>{1.5, 2});
+
+    auto const args = parser.parse_args(2, cstr_arr{"prog", "-c"});
+
+    CHECK(parser.to_json(args) == R"({"c":[1.5,2],"n":"auto","ratio":0.5,"sizes":["a","b"]})");
+}
+
+TEST_CASE("Values of custom types are written as JSON strings")
+{
+    auto parser = argparse::ArgumentParser().add_help(false);
+    parser.add_argument("-c").type<foo::Custom>();
+
+    auto const args = parser.parse_args(3, cstr_arr{"prog", "-c", "x"});
+
+    CHECK(parser.to_json(args) == R"({"c":"<Custom: x>"})");
+}
@@ -0,0 +1,314 @@
+#include "argparse.hpp"
+
+#include "cstring_array.h"
+
+#include "doctest.h"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+    struct Throwing
+    {
+    };
+}
+
+template<>
+class argparse::Converter<Throwing>
+{
+    public:
+        auto from_string(std::string const &) const -> std::optional<Throwing>
+        {
+            throw 42;
+        }
+
+        auto to_string(Throwing const &) const -> std::string
+        {
+            return "";
+        }
+
+        auto are_equal(Throwing const &, Throwing const &) const -> bool
+        {
+            return true;
+        }
+};
+
+TEST_CASE("Parameters give access to values by reference")
+{
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("pos");
+    parser.add_argument("-o").type<int>();
+
+    auto const args = parser.parse_args(4, cstr_arr{"prog", "value", "-o", "7"});
+
+    CHECK(args.get_value_ref("pos") == "value");
+    CHECK(args.get_value_ref<int>("o") == 7);
+    CHECK(&args.get_value_ref<int>("o") == &args.get_value_ref<int>("o"));
+    CHECK_THROWS_WITH_AS(args.get_value_ref<int>("x"), "no such argument: 'x'", argparse::name_error);
+}
+
+TEST_CASE("Parameters give access to values of wrong type by reference throws an exception")
+{
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("-o").type<int>();
+
+    auto const args = parser.parse_args(3, cstr_arr{"prog", "-o", "7"});
+
+    CHECK_THROWS_AS(args.get_value_ref("o"), argparse::type_error);
+}
+
+TEST_CASE("Parameters in sparse mode give access to default values by reference")
+{
+    auto parser = argparse::ArgumentParser().sparse(true);
+    parser.add_argument("-o").default_(std::string("default"));
+
+    auto const args = parser.parse_args(1, cstr_arr{"prog"});
+
+    CHECK(args.get_value_ref("o") == "default");
+}
+
+TEST_CASE("Shared parameters are empty until published")
+{
+    auto const shared = argparse::ArgumentParser::SharedParameters();
+
+    CHECK(shared.load() == nullptr);
+}
+
+TEST_CASE("Shared parameters keep old snapshot alive while new one is published")
+{
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("-o");
+
+    auto shared = argparse::ArgumentParser::SharedParameters(parser.parse_args(3, cstr_arr{"prog", "-o", "old"}));
+    auto const old = shared.load();
+
+    (void) shared.publish(parser.parse_args(3, cstr_arr{"prog", "-o", "new"}));
+
+    CHECK(old->get_value_ref("o") == "old");
+    CHECK(shared.load()->get_value_ref("o") == "new");
+}
+
+TEST_CASE("Shared parameters can be read by many threads while being published")
+{
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("-o").type<int>();
+
+    auto shared = argparse::ArgumentParser::SharedParameters(parser.parse_args(3, cstr_arr{"prog", "-o", "0"}));
+    auto done = std::atomic<bool>(false);
+    auto failures = std::atomic<int>(0);
+
+    auto readers = std::vector<std::jthread>();
+    for (auto i = 0; i != 4; ++i)
+    {
+        readers.emplace_back([&]
+        {
+            auto last = 0;
+            while (!done.load())
+            {
+                auto const current = shared.load()->get_value_ref<int>("o");
+                if (current < last)
+                {
+                    ++failures;
+                }
+                last = current;
+            }
+        });
+    }
+
+    for (auto i = 1; i != 100; ++i)
+    {
+        (void) shared.publish(parser.parse_args(3, cstr_arr{"prog", "-o", std::to_string(i).c_str()}));
+    }
+
+    done = true;
+    readers.clear();
+
+    CHECK(failures == 0);
+    CHECK(shared.load()->get_value<int>("o") == 99);
+}
+
+namespace
+{
+    auto get_unique_path(std::string const & name) -> std::filesystem::path
+    {
+        static auto counter = std::atomic<unsigned>(0);
+        auto const seed = std::random_device()();
+        return std::filesystem::temp_directory_path() / std::format("argparse_{}_{:08x}_{}.txt", name, seed, counter++);
+    }
+
+    auto write_file(std::filesystem::path const & path, std::string const & content) -> void
+    {
+        std::ofstream(path) << content;
+        std::filesystem::last_write_time(path, std::filesystem::last_write_time(path) + std::chrono::seconds(1));
+    }
+
+    auto wait_for(auto predicate) -> bool
+    {
+        for (auto i = 0; i != 500; ++i)
+        {
+            if (predicate())
+            {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        return false;
+    }
+}
+
+TEST_CASE("Watching argument file publishes parsed arguments and reloads them on change")
+{
+    auto const path = get_unique_path("watch_reload");
+    write_file(path, "-o\n1\n");
+
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("-o").type<int>();
+
+    auto shared = std::make_shared<argparse::ArgumentParser::SharedParameters>();
+    auto watcher = parser.watch(path, shared, std::chrono::milliseconds(5));
+
+    CHECK(wait_for([&] { return shared->load() != nullptr; }));
+    CHECK(shared->load()->get_value<int>("o") == 1);
+
+    write_file(path, "-o\n2\n");
+
+    CHECK(wait_for([&] { return shared->load()->get_value<int>("o") == 2; }));
+
+    watcher = {};
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Watching argument file reloads it when content changes without changing modification time or size")
+{
+    auto const path = get_unique_path("watch_same_stamp");
+    write_file(path, "-o\n1\n");
+    auto const write_time = std::filesystem::last_write_time(path);
+
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("-o").type<int>();
+
+    auto shared = std::make_shared<argparse::ArgumentParser::SharedParameters>();
+    auto watcher = parser.watch(path, shared, std::chrono::milliseconds(5));
+
+    CHECK(wait_for([&] { return shared->load() != nullptr; }));
+
+    write_file(path, "-o\n2\n");
+    std::filesystem::last_write_time(path, write_time);
+
+    CHECK(wait_for([&] { return shared->load()->get_value<int>("o") == 2; }));
+
+    watcher = {};
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Watching argument file reports exceptions not derived from std::exception")
+{
+    auto const path = get_unique_path("watch_unknown_error");
+    write_file(path, "-o\n1\n");
+
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("-o").type<Throwing>();
+
+    auto shared = std::make_shared<argparse::ArgumentParser::SharedParameters>();
+    auto error = std::string();
+    auto errors = std::atomic<int>(0);
+    auto watcher = parser.watch(path, shared, std::chrono::milliseconds(5), [&](std::string const & message)
+    {
+        if (errors == 0)
+        {
+            error = message;
+        }
+        ++errors;
+    });
+
+    CHECK(wait_for([&] { return errors > 0; }));
+    watcher = {};
+
+    CHECK(error == "unknown error");
+    CHECK(shared->load() == nullptr);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Watching argument file keeps previous result when reloaded arguments are invalid")
+{
+    auto const path = get_unique_path("watch_invalid");
+    write_file(path, "-o\n1\n");
+
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("-o").type<int>();
+
+    auto shared = std::make_shared<argparse::ArgumentParser::SharedParameters>();
+    auto error = std::string();
+    auto errors = std::atomic<int>(0);
+    auto watcher = parser.watch(path, shared, std::chrono::milliseconds(5), [&](std::string const & message)
+    {
+        error = message;
+        ++errors;
+    });
+
+    CHECK(wait_for([&] { return shared->load() != nullptr; }));
+    auto const previous = shared->load();
+
+    write_file(path, "-o\nx\n");
+
+    CHECK(wait_for([&] { return errors > 0; }));
+    CHECK(error == "argument -o: invalid value: 'x'");
+    CHECK(shared->load() == previous);
+    CHECK(shared->load()->get_value<int>("o") == 1);
+
+    watcher = {};
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Watching argument file stops when watcher is destroyed")
+{
+    auto parser = argparse::ArgumentParser();
+    auto shared = std::make_shared<argparse::ArgumentParser::SharedParameters>();
+
+    auto const start = std::chrono::steady_clock::now();
+    {
+        auto watcher = parser.watch(get_unique_path("watch_missing"), shared, std::chrono::hours(1));
+    }
+
+    CHECK(std::chrono::steady_clock::now() - start < std::chrono::minutes(1));
+    CHECK(shared->load() == nullptr);
+}
+
+TEST_CASE("Watching argument file keeps the shared parameters alive while it runs")
+{
+    auto const path = get_unique_path("watch_ownership");
+    write_file(path, "-o\n1\n");
+
+    auto parser = argparse::ArgumentParser();
+    parser.add_argument("-o").type<int>();
+
+    auto shared = std::make_shared<argparse::ArgumentParser::SharedParameters>();
+    auto const weak = std::weak_ptr(shared);
+    auto watcher = parser.watch(path, std::move(shared), std::chrono::milliseconds(5));
+
+    CHECK(wait_for([&] { auto const current = weak.lock(); return current && current->load() != nullptr; }));
+    CHECK(!weak.expired());
+
+    watcher = {};
+
+    CHECK(weak.expired());
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Watching argument file without shared parameters throws an exception")
+{
+    auto parser = argparse::ArgumentParser();
+
+    CHECK_THROWS_WITH_AS(parser.watch(get_unique_path("watch_null"), nullptr), "watch needs a SharedParameters to publish to", argparse::option_error);
+}
@@ -0,0 +1,118 @@
+#include "argparse.hpp"
+
+#include "doctest.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+using namespace std::string_literals;
+
+namespace
+{
+    auto split(std::string_view command) -> std::vector<std::string>
+    {
+        auto const words = argparse::ShellWords(command);
+        return std::vector<std::string>(words.begin(), words.end());
+    }
+
+    auto points_into(std::string_view word, std::string_view command) -> bool
+    {
+        return word.data() >= command.data() && word.data() + word.size() <= command.data() + command.size();
+    }
+}
+
+TEST_CASE("Splitting a command splits it on blanks")
+{
+    CHECK(split("") == std::vector<std::string>{});
+    CHECK(split(" \t\r\n ") == std::vector<std::string>{});
+    CHECK(split("a") == std::vector<std::string>{"a"});
+    CHECK(split("  --foo  bar\tbaz\nqux  ") == std::vector<std::string>{"--foo", "bar", "baz", "qux"});
+}
+
+TEST_CASE("Splitting a command handles single quotes")
+{
+    CHECK(split("'a b' c") == std::vector<std::string>{"a b", "c"});
+    CHECK(split("'a \\\" b'") == std::vector<std::string>{"a \\\" b"});
+    CHECK(split("''") == std::vector<std::string>{""});
+    CHECK(split("a'b c'd") == std::vector<std::string>{"ab cd"});
+}
+
+TEST_CASE("Splitting a command handles double quotes")
+{
+    CHECK(split("\"a b\" c") == std::vector<std::string>{"a b", "c"});
+    CHECK(split("\"a \\\" \\\\ \\$ \\` b\"") == std::vector<std::string>{"a \" \\ $ ` b"});
+    CHECK(split("\"a \\n b\"") == std::vector<std::string>{"a \\n b"});
+    CHECK(split("\"a\\\nb\"") == std::vector<std::string>{"ab"});
+    CHECK(split("\"\"") == std::vector<std::string>{""});
+    CHECK(split("--name=\"a b\"'c d'") == std::vector<std::string>{"--name=a bc d"});
+}
+
+TEST_CASE("Splitting a command handles escapes outside quotes")
+{
+    CHECK(split("a\\ b") == std::vector<std::string>{"a b"});
+    CHECK(split("\\'a\\\"") == std::vector<std::string>{"'a\""});
+    CHECK(split("a\\\nb") == std::vector<std::string>{"ab"});
+    CHECK(split("a \\\n b") == std::vector<std::string>{"a", "b"});
+}
+
+TEST_CASE("Splitting a command skips comments at the start of a word")
+{
+    CHECK(split("a # b c\nd") == std::vector<std::string>{"a", "d"});
+    CHECK(split("# comment") == std::vector<std::string>{});
+    CHECK(split("a#b '#c'") == std::vector<std::string>{"a#b", "#c"});
+}
+
+TEST_CASE("Splitting a command handles words longer than the scan width")
+{
+    CHECK(split("--a-rather-long-option-name=value with-more-words\t'and a quoted one'") == std::vector<std::string>{"--a-rather-long-option-name=value", "with-more-words", "and a quoted one"});
+}
+
+TEST_CASE("Splitting a command returns views into the command for words that need no unescaping")
+{
+    auto const command = std::string_view("plain 'quoted word' \"double\" esc\\ aped");
+    auto const words = argparse::ShellWords(command);
+
+    REQUIRE(words.size() == 4);
+    CHECK(points_into(words[0], command));
+    CHECK(points_into(words[1], command));
+    CHECK(points_into(words[2], command));
+    CHECK(!points_into(words[3], command));
+    CHECK(words[3] == "esc aped");
+}
+
+TEST_CASE("Splitting a command with unterminated quotes results in error")
+{
+    CHECK_THROWS_WITH_AS(argparse::ShellWords("'a"), "no closing quotation", argparse::parsing_error);
+    CHECK_THROWS_WITH_AS(argparse::ShellWords("\"a"), "no closing quotation", argparse::parsing_error);
+    CHECK_THROWS_WITH_AS(argparse::ShellWords("\"a\\"), "no closing quotation", argparse::parsing_error);
+}
+
+TEST_CASE("Splitting a command with trailing backslash results in error")
+{
+    CHECK_THROWS_WITH_AS(argparse::ShellWords("a\\"), "no escaped character", argparse::parsing_error);
+}
+
+TEST_CASE("Parsing a command splits it and parses the words as arguments")
+{
+    auto parser = argparse::ArgumentParser().prog("admin");
+    parser.add_argument("command");
+    parser.add_argument("--name");
+    parser.add_argument("--threads").type<int>();
+
+    auto const args = parser.parse_command("set --name 'my server' --threads=4 # trailing comment");
+
+    CHECK(args.get_value("command") == "set");
+    CHECK(args.get_value("name") == "my server");
+    CHECK(args.get_value<int>("threads") == 4);
+    CHECK(parser.format_usage() == "usage: admin [-h] [--name NAME] [--threads THREADS] command"s);
+}
+
+TEST_CASE("Parsing a command with unterminated quotes results in error")
+{
+    auto parser = argparse::ArgumentParser().handle(argparse::Handle::none);
+    parser.add_argument("command");
+
+    CHECK_THROWS_WITH_AS(parser.parse_command("set 'my server"), "no closing quotation", argparse::parsing_error);
+}